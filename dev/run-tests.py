@@ -2,8 +2,11 @@
 # -*- coding: utf-8 -*-
 
 import argparse
+import json
 import os
+import shutil
 import subprocess
+import tempfile
 import timeit
 
 from itertools import product
@@ -26,59 +29,195 @@ OPTIMAL_PLAN_COSTS = {'domains/airport/p05-airport2-p1.pddl': 21,
                       'domains/gripper/prob01.pddl': 11,
                       'domains/movie/prob30.pddl': 7,
                       'domains/openstacks/p01.pddl': 17,
-                      'domains/organic-synthesis/p05.pddl': 2}
+                      'domains/organic-synthesis/p05.pddl': 2,
+                      'domains/corridor/p01.pddl': 9,
+                      'domains/colored-paths/p01.pddl': 3,
+                      'domains/toll-roads/p01.pddl': 130}
 SEARCH_CONFIGS = ['bfs', 'gbfs']
 HEURISTIC_CONFIGS = ['blind']
-GENERATOR_CONFIGS = ['full_reducer', 'join', 'yannakakis']
+GENERATOR_CONFIGS = ['full_reducer', 'join', 'yannakakis', 'hybrid']
 STATE_REPR_CONFIGS = ['sparse', 'extensional']
 
+# Configurations with additional options, tested on every instance. Each entry is
+# (search, heuristic, generator, state representation, options, optimal). If the
+# configuration is not optimal, we only check that it finds a valid plan.
+OPTION_CONFIGS = [
+    ('bfs', 'blind', 'yannakakis', 'sparse', ['--stubborn-sets'], True),
+    ('gbfs', 'blind', 'yannakakis', 'extensional', ['--stubborn-sets'], True),
+    ('bfs', 'blind', 'yannakakis', 'sparse', ['--orbit-search'], True),
+    ('gbfs', 'blind', 'full_reducer', 'sparse', ['--orbit-search'], True),
+    ('bfs', 'blind', 'yannakakis', 'sparse', ['--cache-instantiations'], True),
+    ('gbfs', 'blind', 'hybrid', 'extensional', ['--cache-instantiations'], True),
+    ('bfs', 'blind', 'yannakakis', 'sparse', ['--invariants'], True),
+    ('gbfs', 'blind', 'hybrid', 'sparse', ['--invariants'], True),
+    ('bfs', 'blind', 'yannakakis', 'sparse', ['--postprocess-plan'], True),
+    ('gbfs', 'blind', 'yannakakis', 'sparse', ['--postprocess-plan'], False),
+    ('ehc', 'blind', 'yannakakis', 'sparse', [], False),
+    ('beam', 'blind', 'yannakakis', 'sparse', ['--beam-width', '1000'], False),
+    ('alt', 'goalcount', 'yannakakis', 'sparse', ['--alternation-heuristics', 'blind'], False),
+    ('alt', 'goalcount', 'yannakakis', 'extensional',
+     ['--alternation-heuristics', 'blind', '--lazy-evaluation'], False),
+    ('alt-po', 'goalcount', 'yannakakis', 'sparse', ['--alternation-heuristics', 'blind'], False),
+    ('alt', 'goalcount', 'yannakakis', 'sparse', ['--alternation-heuristics', 'add'], False),
+]
+
+# Configurations run twice with a translation cache, given as (search, heuristic,
+# generator, state representation). The second run must reuse the cached translation.
+TRANSLATION_CACHE_CONFIGS = [('gbfs', 'blind', 'yannakakis', 'sparse'),
+                             ('gbfs', 'hmax', 'yannakakis', 'sparse')]
+
+# Configurations interrupted after writing a checkpoint and then resumed from it,
+# given as (search, heuristic, generator, state representation).
+RESUME_CONFIGS = [('bfs', 'blind', 'yannakakis', 'sparse'),
+                  ('gbfs', 'blind', 'yannakakis', 'extensional')]
+CHECKPOINT_FILE = 'test-checkpoint'
+
+# Configurations run with a telemetry file, given as (search, heuristic, generator,
+# state representation). A record is written every TELEMETRY_EXPANSIONS expansions.
+TELEMETRY_CONFIGS = [('gbfs', 'blind', 'yannakakis', 'sparse')]
+TELEMETRY_FILE = 'test-telemetry'
+TELEMETRY_EXPANSIONS = 2
+
+# Limits that are exceeded right away, given as (options, exit code, message). Each one
+# is tested with every configuration in BUDGET_CONFIGS, and with the SAT planner if
+# --sat is given.
+BUDGET_LIMITS = [(['--time-limit', '0.0001'], 23, b'Time limit reached'),
+                 (['--memory-limit', '1'], 22, b'Memory limit reached')]
+BUDGET_CONFIGS = [('bfs', 'blind', 'yannakakis', 'sparse'),
+                  ('lazy', 'goalcount', 'yannakakis', 'extensional')]
+
+# Configurations of the SAT planner, given as (options, optimal). They are only
+# tested with --sat, on the instances in SAT_INSTANCES, as the planner must be built
+# with SAT support. The SAT planner runs in optimal mode up to SAT_PLAN_LENGTH.
+# The static table of colored-paths is encoded as a multi-valued decision diagram.
+SAT_CONFIGS = [([], True),
+               (['--invariants'], True),
+               (['--step-slots', '2'], False),
+               (['--sat-log-encoding', '1'], True),
+               (['--incremental'], True),
+               (['--postprocess-plan'], True)]
+SAT_INSTANCES = ['domains/blocks/probBLOCKS-4-0.pddl',
+                 'domains/gripper/prob01.pddl',
+                 'domains/organic-synthesis/p05.pddl',
+                 'domains/colored-paths/p01.pddl']
+SAT_PLAN_LENGTH = 20
+
+# Grounding thresholds of the hybrid generator tested on some instances, given as
+# (threshold, number of grounded action schemas). With threshold 5, only one schema
+# of gripper is grounded and the other ones stay lifted.
+GROUNDING_THRESHOLD_CONFIGS = {'domains/gripper/prob01.pddl': [(5, 1), (20, 3)]}
+
+# Initial heuristic values of the lifted Datalog heuristics on every instance. The
+# actions of toll-roads cost more than the largest rule weight grounded in cost
+# layers, so its Datalog program is grounded with a priority queue.
+INITIAL_ADD_VALUES = {'domains/airport/p05-airport2-p1.pddl': 68,
+                      'domains/blocks/probBLOCKS-4-0.pddl': 6,
+                      'domains/gripper/prob01.pddl': 12,
+                      'domains/movie/prob30.pddl': 7,
+                      'domains/openstacks/p01.pddl': 16,
+                      'domains/organic-synthesis/p05.pddl': 4,
+                      'domains/corridor/p01.pddl': 5,
+                      'domains/colored-paths/p01.pddl': 4,
+                      'domains/toll-roads/p01.pddl': 170}
+INITIAL_HMAX_VALUES = {'domains/airport/p05-airport2-p1.pddl': 20,
+                       'domains/blocks/probBLOCKS-4-0.pddl': 2,
+                       'domains/gripper/prob01.pddl': 2,
+                       'domains/movie/prob30.pddl': 1,
+                       'domains/openstacks/p01.pddl': 1,
+                       'domains/organic-synthesis/p05.pddl': 2,
+                       'domains/corridor/p01.pddl': 5,
+                       'domains/colored-paths/p01.pddl': 3,
+                       'domains/toll-roads/p01.pddl': 100}
+UNIT_COST_ADD_VALUES = dict(INITIAL_ADD_VALUES, **{'domains/openstacks/p01.pddl': 44,
+                                                   'domains/toll-roads/p01.pddl': 8})
+UNIT_COST_HMAX_VALUES = dict(INITIAL_HMAX_VALUES, **{'domains/openstacks/p01.pddl': 4,
+                                                     'domains/toll-roads/p01.pddl': 5})
+INITIAL_GOALCOUNT_VALUES = {'domains/airport/p05-airport2-p1.pddl': 1,
+                            'domains/blocks/probBLOCKS-4-0.pddl': 3,
+                            'domains/gripper/prob01.pddl': 4,
+                            'domains/movie/prob30.pddl': 7,
+                            'domains/openstacks/p01.pddl': 5,
+                            'domains/organic-synthesis/p05.pddl': 2,
+                            'domains/corridor/p01.pddl': 1,
+                            'domains/colored-paths/p01.pddl': 2,
+                            'domains/toll-roads/p01.pddl': 2}
+
+# Configurations whose initial heuristic value is checked, given as
+# (search, heuristic, generator, state representation, options, initial values).
+# The search itself only has to find a valid plan.
+HEURISTIC_VALUE_CONFIGS = [
+    ('gbfs', 'add', 'yannakakis', 'sparse', [], INITIAL_ADD_VALUES),
+    ('gbfs', 'hmax', 'yannakakis', 'sparse', [], INITIAL_HMAX_VALUES),
+    ('gbfs', 'add', 'yannakakis', 'sparse', ['--unit-cost'], UNIT_COST_ADD_VALUES),
+    ('gbfs', 'hmax', 'yannakakis', 'sparse', ['--unit-cost'], UNIT_COST_HMAX_VALUES),
+    ('gbfs', 'goalcount', 'yannakakis', 'sparse', [], INITIAL_GOALCOUNT_VALUES),
+    ('gbfs', 'goalcount', 'yannakakis', 'extensional', [], INITIAL_GOALCOUNT_VALUES),
+]
+
 
 class TestRun:
-    def __init__(self, instance, config):
+    def __init__(self, instance, config, options=(), optimal=True):
         self.instance = instance
         self.search = config[0]
         self.heuristic = config[1]
         self.generator = config[2]
         self.state_representation = config[3]
+        self.options = list(options)
+        self.optimal = optimal
 
     def get_config(self):
-        return "{}, {}, {}, and {}".format(self.search,
-                                           self.heuristic,
-                                           self.generator,
-                                           self.state_representation)
+        config = "{}, {}, {}, and {}".format(self.search,
+                                             self.heuristic,
+                                             self.generator,
+                                             self.state_representation)
+        if self.options:
+            config += " [{}]".format(' '.join(self.options))
+        return config
+
+    def get_command(self):
+        return [os.path.join(BASEDIR, 'powerlifted.py'),
+                '-i', os.path.join(BASEDIR, 'dev', self.instance),
+                '-s', self.search,
+                '-e', self.heuristic,
+                '-g', self.generator,
+                '--state', self.state_representation] + self.options
 
     def __str__(self):
         return "{} with {}".format(self.instance, self.get_config())
 
     def run(self):
         print("Testing {} with {}: ".format(self.instance, self.get_config()), end='', flush=True)
-        output = subprocess.check_output([os.path.join(BASEDIR, 'powerlifted.py'),
-                                          '-i', os.path.join(BASEDIR, 'dev', self.instance),
-                                          '-s', self.search,
-                                          '-e', self.heuristic,
-                                          '-g', self.generator,
-                                          '--state', self.state_representation,
-                                          '--validate'])
+        output = subprocess.check_output(self.get_command() + ['--validate'])
         return output
 
     def evaluate(self, output, optimal_cost):
         plan_length_found = None
         plan_valid = None
+        # The planner reports the actions removed by plan post-processing.
+        postprocessed = '--postprocess-plan' not in self.options
         for line in output.splitlines():
             if b'Total plan cost:' in line:
                 plan_length_found = int(line.split()[3])
             if b'Plan valid' in line:
                 plan_valid = True
+            if line.startswith(b'Plan post-processing:'):
+                postprocessed = True
 
-        if plan_length_found == optimal_cost and plan_valid:
+        if self.optimal:
+            cost_ok = plan_length_found == optimal_cost
+        else:
+            cost_ok = plan_length_found is not None and plan_length_found >= optimal_cost
+        if cost_ok and plan_valid and postprocessed:
             print("PASSED")
             return True
         else:
             print("FAILED ", end="")
-            if plan_length_found != optimal_cost:
+            if not cost_ok:
                 print("[expected: {}, plan length found: {}]".format(optimal_cost, plan_length_found), end="")
             if not plan_valid:
                 print("[VAL did not validate the plan]", end="")
+            if not postprocessed:
+                print("[the plan was not post-processed]", end="")
             print("")
             return False
 
@@ -88,6 +227,189 @@ class TestRun:
             os.remove(plan_file)
 
 
+class CachedTranslationTestRun(TestRun):
+    """
+    Translate the task into an empty translation cache, and then check the plan
+    found when the translation is taken from the cache.
+    """
+    def get_config(self):
+        return super().get_config() + " with a translation cache"
+
+    def run(self):
+        print("Testing {} with {}: ".format(self.instance, self.get_config()), end='', flush=True)
+        cache_dir = tempfile.mkdtemp(prefix='translation-cache-')
+        try:
+            cache = ['--translation-cache', cache_dir]
+            subprocess.check_output(self.get_command() + cache)
+            return subprocess.check_output(self.get_command() + cache + ['--validate'])
+        finally:
+            shutil.rmtree(cache_dir, ignore_errors=True)
+
+    def evaluate(self, output, optimal_cost):
+        if b'Reusing translation from cache entry' not in output:
+            print("FAILED [the translation was not taken from the cache]")
+            return False
+        return super().evaluate(output, optimal_cost)
+
+
+class ResumeTestRun(TestRun):
+    """
+    Interrupt the search right after it writes a checkpoint, and then check the plan
+    found when the search is resumed from the checkpoint.
+    """
+    def get_config(self):
+        return super().get_config() + " resumed from a checkpoint"
+
+    def run(self):
+        print("Testing {} with {}: ".format(self.instance, self.get_config()), end='', flush=True)
+        checkpoint = ['--checkpoint-file', CHECKPOINT_FILE]
+        subprocess.run(self.get_command() + checkpoint +
+                       ['--checkpoint-interval', '0.001', '--time-limit', '0.0001'],
+                       stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        return subprocess.check_output(self.get_command() + checkpoint +
+                                       ['--checkpoint-interval', '60', '--resume', '--validate'])
+
+    def evaluate(self, output, optimal_cost):
+        if b'Resuming from checkpoint' not in output:
+            print("FAILED [the search was not resumed from the checkpoint]")
+            return False
+        return super().evaluate(output, optimal_cost)
+
+    def remove_plan_file(self):
+        super().remove_plan_file()
+        for f in os.listdir('.'):
+            if f.startswith(CHECKPOINT_FILE):
+                os.remove(f)
+
+
+class TelemetryTestRun(TestRun):
+    """
+    Check that the telemetry file holds records, one JSON object per line, with
+    non-decreasing expansion counters, in addition to the plan found.
+    """
+    def __init__(self, instance, config):
+        super().__init__(instance, config,
+                         ['--telemetry-file', TELEMETRY_FILE,
+                          '--telemetry-expansions', str(TELEMETRY_EXPANSIONS)],
+                         optimal=False)
+
+    def evaluate(self, output, optimal_cost):
+        try:
+            with open(TELEMETRY_FILE) as f:
+                records = [json.loads(line) for line in f]
+        except (OSError, ValueError) as e:
+            print("FAILED [invalid telemetry file: {}]".format(e))
+            return False
+        if not records:
+            print("FAILED [the telemetry file is empty]")
+            return False
+        expanded = [record['expanded'] for record in records]
+        if expanded != sorted(expanded):
+            print("FAILED [the expansion counters in the telemetry file decrease]")
+            return False
+        return super().evaluate(output, optimal_cost)
+
+    def remove_plan_file(self):
+        super().remove_plan_file()
+        if os.path.isfile(TELEMETRY_FILE):
+            os.remove(TELEMETRY_FILE)
+
+
+class BudgetTestRun:
+    """
+    Run another test with a limit that is exceeded right away, and check that the
+    planner stops cleanly with the exit code of the limit.
+    """
+    def __init__(self, test, options, exit_code, message):
+        self.test = test
+        self.options = options
+        self.exit_code = exit_code
+        self.message = message
+        self.returncode = None
+
+    def run(self):
+        print("Testing {} with {} [{}]: ".format(self.test.instance, self.test.get_config(),
+                                                ' '.join(self.options)), end='', flush=True)
+        process = subprocess.run(self.test.get_command() + self.options,
+                                 stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        self.returncode = process.returncode
+        return process.stdout
+
+    def evaluate(self, output, optimal_cost):
+        if self.returncode == self.exit_code and self.message in output:
+            print("PASSED")
+            return True
+        print("FAILED [expected exit code {}, found {}]".format(self.exit_code, self.returncode))
+        return False
+
+    def remove_plan_file(self):
+        self.test.remove_plan_file()
+
+
+class SatTestRun(TestRun):
+    def __init__(self, instance, options, optimal):
+        super().__init__(instance, ('sat', None, 'yannakakis', 'sparse'), options, optimal)
+
+    def get_config(self):
+        config = "sat"
+        if self.options:
+            config += " [{}]".format(' '.join(self.options))
+        return config
+
+    def get_command(self):
+        return [os.path.join(BASEDIR, 'powerlifted.py'),
+                '-i', os.path.join(BASEDIR, 'dev', self.instance),
+                '-s', 'sat',
+                '-g', self.generator,
+                '-o', '-l', str(SAT_PLAN_LENGTH)] + self.options
+
+
+class GroundingThresholdTestRun(TestRun):
+    """
+    Check the number of action schemas grounded by the hybrid generator in addition
+    to the plan found.
+    """
+    def __init__(self, instance, threshold, grounded_schemas):
+        super().__init__(instance, ('bfs', 'blind', 'hybrid', 'sparse'),
+                         ['--grounding-threshold', str(threshold)])
+        self.grounded_schemas = grounded_schemas
+
+    def evaluate(self, output, optimal_cost):
+        grounded_schemas_found = None
+        for line in output.splitlines():
+            if line.startswith(b'Grounded'):
+                grounded_schemas_found = int(line.split()[1])
+        if grounded_schemas_found != self.grounded_schemas:
+            print("FAILED [expected grounded action schemas: {}, found: {}]".format(
+                self.grounded_schemas, grounded_schemas_found))
+            return False
+        return super().evaluate(output, optimal_cost)
+
+
+class HeuristicValueTestRun(TestRun):
+    """
+    Check the heuristic value of the initial state in addition to the plan found.
+    """
+    def __init__(self, instance, config, options, initial_values):
+        super().__init__(instance, config, options, optimal=False)
+        self.initial_value = initial_values[instance]
+
+    def evaluate(self, output, optimal_cost):
+        initial_value_found = None
+        for line in output.splitlines():
+            if b'Initial heuristic value' in line:
+                initial_value_found = int(line.split()[3])
+        if initial_value_found != self.initial_value:
+            print("FAILED [expected initial heuristic value: {}, found: {}]".format(
+                self.initial_value, initial_value_found))
+            return False
+        if '--unit-cost' in self.options:
+            # The cost of the plan is its length, which cannot be compared with
+            # the optimal cost of the task
+            optimal_cost = 0
+        return super().evaluate(output, optimal_cost)
+
+
 def print_summary(passes, failures, starting_time):
     total = passes + failures
     print("Total number of passed tests: %d/%d" % (passes, total))
@@ -99,6 +421,8 @@ def parse_options():
     parser = argparse.ArgumentParser()
     parser.add_argument('--minimal', dest='minimal', action='store_true',
                         help='Use minimal test set.')
+    parser.add_argument('--sat', dest='sat', action='store_true',
+                        help='Also test the SAT planner (requires a build with SAT support).')
     args = parser.parse_args()
 
     return args
@@ -110,7 +434,8 @@ if __name__ == '__main__':
     if args.minimal:
         OPTIMAL_PLAN_COSTS = {'domains/blocks/probBLOCKS-4-0.pddl': 6,
                               'domains/gripper/prob01.pddl': 11,
-                              'domains/movie/prob30.pddl': 7}
+                              'domains/movie/prob30.pddl': 7,
+                              'domains/corridor/p01.pddl': 9}
         SEARCH_CONFIGS = ['bfs', 'gbfs']
         HEURISTIC_CONFIGS = ['blind']
         GENERATOR_CONFIGS = ['full_reducer', 'yannakakis']
@@ -120,8 +445,23 @@ if __name__ == '__main__':
     failures = 0
     passes = 0
     for instance, cost in OPTIMAL_PLAN_COSTS.items():
-        for config in product(SEARCH_CONFIGS, HEURISTIC_CONFIGS, GENERATOR_CONFIGS, STATE_REPR_CONFIGS):
-            test = TestRun(instance, config)
+        tests = [TestRun(instance, config) for config in
+                 product(SEARCH_CONFIGS, HEURISTIC_CONFIGS, GENERATOR_CONFIGS, STATE_REPR_CONFIGS)]
+        tests += [TestRun(instance, config[:4], config[4], config[5]) for config in OPTION_CONFIGS]
+        tests += [CachedTranslationTestRun(instance, config, optimal=False)
+                  for config in TRANSLATION_CACHE_CONFIGS]
+        tests += [ResumeTestRun(instance, config) for config in RESUME_CONFIGS]
+        tests += [TelemetryTestRun(instance, config) for config in TELEMETRY_CONFIGS]
+        tests += [GroundingThresholdTestRun(instance, threshold, grounded_schemas)
+                  for threshold, grounded_schemas in GROUNDING_THRESHOLD_CONFIGS.get(instance, [])]
+        tests += [HeuristicValueTestRun(instance, config[:4], config[4], config[5])
+                  for config in HEURISTIC_VALUE_CONFIGS]
+        budget_tests = [TestRun(instance, config) for config in BUDGET_CONFIGS]
+        if args.sat and instance in SAT_INSTANCES:
+            tests += [SatTestRun(instance, options, optimal) for options, optimal in SAT_CONFIGS]
+            budget_tests.append(SatTestRun(instance, [], True))
+        tests += [BudgetTestRun(test, *limit) for test in budget_tests for limit in BUDGET_LIMITS]
+        for test in tests:
             output = test.run()
             passed = test.evaluate(output, cost)
             if passed:
@@ -3,10 +3,14 @@
 
 import argparse
 import errno
+import fcntl
+import hashlib
 import logging
 import os
+import shutil
 import subprocess
 import sys
+import tempfile
 from pathlib import Path
 
 from build import build, PROJECT_ROOT
@@ -24,21 +28,61 @@ def parse_options():
     parser.add_argument('--debug', dest='debug', action='store_true',
                         help='Run planner in debug mode.')
     parser.add_argument('-s', '--search', dest='search', action='store',
-                        default=None, help='Search algorithm', choices=("naive", "bfs", "gbfs", "lazy", "lazy-po", "lazy-prune", "sat"),
+                        default=None, help='Search algorithm', choices=("naive", "bfs", "gbfs", "lazy", "lazy-po", "lazy-prune", "alt", "alt-po", "ehc", "ehc-prune", "beam", "sat"),
                         required=True)
     parser.add_argument('-e', '--heuristic', dest='heuristic', action='store',
                         default=None, choices=("blind", "goalcount", "add", "hmax"),
                         help='Heuristic to guide the search (ignore in case of blind search)')
     parser.add_argument('-g', '--generator', dest='generator', action='store',
                         default=None, help='Successor generator method',
-                        choices=('yannakakis', 'join', 'random_join', 'ordered_join', 'inverse_ordered_join', 'full_reducer'))
+                        choices=('yannakakis', 'join', 'random_join', 'ordered_join', 'inverse_ordered_join', 'full_reducer', 'hybrid'))
+    parser.add_argument('--cache-instantiations', dest='cache_instantiations', action='store_true',
+                        help='Reuse the applicable instantiations of a schema in states where the relations it reads are unchanged.')
+    parser.add_argument('--invariants', dest='invariants', action='store_true',
+                        help='Synthesize lifted mutex groups to prune the successor generation, detect dead ends and strengthen the SAT encoding.')
+    parser.add_argument('--postprocess-plan', dest='postprocess_plan', action='store_true',
+                        help='Validate the plan and remove redundant actions from it before writing it.')
+    parser.add_argument('--alternation-heuristics', dest='alternation_heuristics', default=None,
+                        help='Comma-separated heuristics alternating with the main heuristic (alt and alt-po only).')
+    parser.add_argument('--lazy-evaluation', dest='lazy_evaluation', action='store_true',
+                        help='Evaluate the main heuristic only for states removed from its own open lists (alt and alt-po only).')
+    parser.add_argument('--beam-width', dest='beam_width', type=int, default=None,
+                        help='Number of states kept per layer (beam search only).')
+    parser.add_argument('--grounding-threshold', dest='grounding_threshold', type=int, default=None,
+                        help='Maximum number of relaxed-reachable ground actions of a schema to ground it (hybrid generator only).')
     parser.add_argument('--state', action='store', help='Successor generator method',
                         default="sparse", choices=("sparse", "extensional"))
     parser.add_argument('--seed', action='store', help='Random seed.',
                         default=1)
+    parser.add_argument('--stubborn-sets', dest='stubborn_sets', action='store_true',
+                        help='Prune successors with strong stubborn sets (bfs and gbfs only).')
+    parser.add_argument('--orbit-search', dest='orbit_search', action='store_true',
+                        help='Detect duplicate states up to object symmetries (sparse states only).')
+    parser.add_argument('--checkpoint-file', dest='checkpoint_file', default=None,
+                        help='Periodically save the search to this file (bfs and gbfs only).')
+    parser.add_argument('--checkpoint-interval', dest='checkpoint_interval', type=float, default=None,
+                        help='Seconds between two checkpoints.')
+    parser.add_argument('--resume', action='store_true',
+                        help='Resume the search from the last checkpoint of the checkpoint file, if there is one.')
+    parser.add_argument('--telemetry-file', dest='telemetry_file', default=None,
+                        help='Write progress records of the search as JSON lines to this file or pipe.')
+    parser.add_argument('--telemetry-interval', dest='telemetry_interval', type=float, default=None,
+                        help='Seconds between two progress records (0 to disable).')
+    parser.add_argument('--telemetry-expansions', dest='telemetry_expansions', type=int, default=None,
+                        help='Expansions between two progress records (0 to disable).')
+    parser.add_argument('--time-limit', dest='time_limit', type=float, default=None,
+                        help='Wall-clock time limit of the search component in seconds.')
+    parser.add_argument('--cpu-time-limit', dest='cpu_time_limit', type=float, default=None,
+                        help='CPU time limit of the search component in seconds.')
+    parser.add_argument('--memory-limit', dest='memory_limit', type=int, default=None,
+                        help='Peak memory limit of the search component in MB.')
     parser.add_argument('-l', '--planLength', action='store', help='Plan length for the SAT encoding', default=100)
     parser.add_argument('-o', '--optimal', action="store_true", help="Run the SAT planner in optimal mode")
-    parser.add_argument('-I', '--incremental', action="store_true", help="Run the SAT planner in incremental mode\nATTENTION: this is not supported by all SAT solvers.")
+    parser.add_argument('-I', '--incremental', action="store_true", help="Run the SAT planner in incremental mode (one solver instance for all plan lengths).")
+    parser.add_argument('--step-slots', dest='step_slots', action='store', default=1,
+                        help='Number of action slots per step of the SAT encoding. With more than one slot, the plan length counts steps.')
+    parser.add_argument('--sat-log-encoding', dest='sat_log_encoding', action='store', default=0,
+                        help='Log-encode the arguments of the SAT encoding whose type has more objects than this (0 for one-hot arguments only).')
     parser.add_argument('--translator-output-file', dest='translator_file',
                         default='output.lifted',
                         help='Output file of the translator')
@@ -55,6 +99,8 @@ def parse_options():
                            help="flag if the actions should be treated as unit-cost actions")
     parser.add_argument("--validate", action="store_true",
                         help="flag if VAL should be called to validate the plan found")
+    parser.add_argument("--translation-cache", dest="translation_cache", default=None,
+                        help="directory where translator outputs are cached and reused")
     args = parser.parse_args()
     if args.domain is None:
         args.domain = find_domain_filename(args.instance)
@@ -93,6 +139,80 @@ def find_domain_filename(task_filename):
             return domain_filename
 
 
+def translation_cache_key(build_dir, domain, instance, translator_options):
+    """
+    Hash the input files, the translator options and the sources of the translator
+    that is actually run from the build directory, so that changes to any of them
+    invalidate the cached outputs.
+    """
+    h = hashlib.sha256()
+    for filename in (domain, instance):
+        h.update(Path(filename).read_bytes())
+        h.update(b'\0')
+    h.update(' '.join(translator_options).encode())
+    translator_dir = Path(build_dir) / 'translator'
+    for source in sorted(translator_dir.rglob('*.py')):
+        h.update(str(source.relative_to(translator_dir)).encode())
+        h.update(source.read_bytes())
+    return h.hexdigest()
+
+
+def run_translator(build_dir, options, translator_options, datalog_file):
+    """
+    Run the translator, reusing its outputs from the translation cache if possible.
+
+    Cache entries are directories named after the cache key. They are written to a
+    temporary directory and atomically renamed once complete, so concurrent readers
+    never see partial entries. A per-key lock avoids translating the same task twice
+    when several planner processes share the cache.
+    """
+    translate = [os.path.join(build_dir, 'translator', 'translate.py'),
+                 options.domain, options.instance, '--output-file', options.translator_file]
+    if options.translation_cache is None:
+        return subprocess.call(translate + translator_options)
+
+    outputs = {'output.lifted': options.translator_file}
+    if datalog_file is not None:
+        outputs['model.lp'] = datalog_file
+
+    # The Datalog file name is irrelevant for the contents of the cache entry
+    key_options = ['DATALOG_FILE' if o == datalog_file else o for o in translator_options]
+    key = translation_cache_key(build_dir, options.domain, options.instance, key_options)
+    cache_dir = Path(options.translation_cache)
+    cache_dir.mkdir(parents=True, exist_ok=True)
+    entry = cache_dir / key
+
+    def restore():
+        for cached, target in outputs.items():
+            shutil.copyfile(entry / cached, target)
+        print(f'Reusing translation from cache entry {entry}')
+
+    if entry.is_dir():
+        restore()
+        return 0
+
+    with open(cache_dir / f'{key}.lock', 'w') as lock:
+        fcntl.flock(lock, fcntl.LOCK_EX)
+        if entry.is_dir():  # Another process translated the task meanwhile
+            restore()
+            return 0
+
+        code = subprocess.call(translate + translator_options)
+        if code != 0:
+            return code
+
+        tmp = Path(tempfile.mkdtemp(dir=cache_dir, prefix=f'.{key}.'))
+        try:
+            for cached, target in outputs.items():
+                shutil.copyfile(target, tmp / cached)
+            os.chmod(tmp, 0o755)
+            os.rename(tmp, entry)
+        except OSError as err:
+            logging.warning(f'Could not store translation in cache: {err}')
+            shutil.rmtree(tmp, ignore_errors=True)
+    return 0
+
+
 def validate(domain_name, instance_name, planfile):
     plan = Path(planfile)
     if not plan.is_file():
@@ -125,8 +245,13 @@ def main():
     if not os.path.exists(build_dir):
         raise OSError("Planner not built!")
 
-    # If it is the lifted heuristic, we need to obtain the Datalog model
-    if options.heuristic == 'add' or options.heuristic == 'hmax':
+    # If the main heuristic or one of the alternation heuristics is a lifted
+    # heuristic, we need to obtain the Datalog model
+    heuristics = [options.heuristic]
+    if options.search in ('alt', 'alt-po'):
+        heuristics += [h.strip() for h in (options.alternation_heuristics or 'goalcount').split(',')]
+    uses_datalog = 'add' in heuristics or 'hmax' in heuristics
+    if uses_datalog:
        PYTHON_EXTRA_OPTIONS += ['--build-datalog-model', '--datalog-file', options.datalog_file]
        if options.keep_action_predicates:
            PYTHON_EXTRA_OPTIONS.append('--keep-action-predicates')
@@ -143,9 +268,8 @@ def main():
 
 
     # Invoke the Python preprocessor
-    subprocess.call([os.path.join(build_dir, 'translator', 'translate.py'),
-                     options.domain, options.instance, '--output-file', options.translator_file] + \
-                    PYTHON_EXTRA_OPTIONS)
+    run_translator(build_dir, options, PYTHON_EXTRA_OPTIONS,
+                   options.datalog_file if uses_datalog else None)
 
 
     if options.search != 'sat':
@@ -157,6 +281,32 @@ def main():
                '-g', options.generator,
                '-r', options.state,
                '--seed', str(options.seed)]
+        if options.stubborn_sets:
+            cmd.append('--stubborn-sets')
+        if options.orbit_search:
+            cmd.append('--orbit-search')
+        if options.cache_instantiations:
+            cmd.append('--cache-instantiations')
+        if options.grounding_threshold is not None:
+            cmd += ['--grounding-threshold', str(options.grounding_threshold)]
+        if options.beam_width is not None:
+            cmd += ['--beam-width', str(options.beam_width)]
+        if options.alternation_heuristics is not None:
+            cmd += ['--alternation-heuristics', options.alternation_heuristics]
+        if options.lazy_evaluation:
+            cmd.append('--lazy-evaluation')
+        if options.checkpoint_file is not None:
+            cmd += ['--checkpoint-file', os.path.abspath(options.checkpoint_file)]
+        if options.checkpoint_interval is not None:
+            cmd += ['--checkpoint-interval', str(options.checkpoint_interval)]
+        if options.resume:
+            cmd.append('--resume')
+        if options.telemetry_file is not None:
+            cmd += ['--telemetry-file', os.path.abspath(options.telemetry_file)]
+        if options.telemetry_interval is not None:
+            cmd += ['--telemetry-interval', str(options.telemetry_interval)]
+        if options.telemetry_expansions is not None:
+            cmd += ['--telemetry-expansions', str(options.telemetry_expansions)]
     else:
         # Invoke the C++ search component
         cmd = [os.path.join(build_dir, 'search', 'search'),
@@ -168,6 +318,18 @@ def main():
             cmd.append('-o')
         if options.incremental:
             cmd.append('-i')
+        cmd += ['--step-slots', str(options.step_slots)]
+        cmd += ['--sat-log-encoding', str(options.sat_log_encoding)]
+    if options.invariants:
+        cmd.append('--invariants')
+    if options.postprocess_plan:
+        cmd.append('--postprocess-plan')
+    if options.time_limit is not None:
+        cmd += ['--time-limit', str(options.time_limit)]
+    if options.cpu_time_limit is not None:
+        cmd += ['--cpu-time-limit', str(options.cpu_time_limit)]
+    if options.memory_limit is not None:
+        cmd += ['--memory-limit', str(options.memory_limit)]
 
     cmd = cmd + \
                CPP_EXTRA_OPTIONS
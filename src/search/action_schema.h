@@ -27,6 +27,14 @@ class ActionSchema {
     std::vector<bool> positive_nullary_effects;
     std::vector<bool> negative_nullary_effects;
 
+    /*
+     * Objects each parameter can be instantiated with in some relaxed-reachable
+     * action, as computed by the translator. An empty vector means the parameter is
+     * unrestricted (beyond its type), and a vector containing only -1 that it cannot
+     * be instantiated at all.
+     */
+    std::vector<std::vector<int>> reachable_objects;
+
 public:
     explicit ActionSchema(std::string name,
                           int index,
@@ -84,6 +92,14 @@ public:
         return negative_nullary_effects;
     }
 
+    const std::vector<std::vector<int>> &get_reachable_objects() const {
+        return reachable_objects;
+    }
+
+    void set_reachable_objects(std::vector<std::vector<int>> objects) {
+        reachable_objects = std::move(objects);
+    }
+
     bool is_ground() const {
         return parameters.empty();
     }
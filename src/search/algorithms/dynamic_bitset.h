@@ -44,6 +44,10 @@ class DynamicBitset {
         return Block(1) << bit_index(pos);
     }
 
+    static int popcount(Block block) {
+        return __builtin_popcountll(static_cast<unsigned long long>(block));
+    }
+
     int count_bits_in_last_block() const {
         return bit_index(num_bits);
     }
@@ -67,16 +71,31 @@ public:
         return num_bits;
     }
 
-    /*
-      Count the number of set bits.
-
-      The computation could be made faster by using a more sophisticated
-      algorithm (see https://en.wikipedia.org/wiki/Hamming_weight).
-    */
+    // Count the number of set bits.
     int count() const {
         int result = 0;
-        for (std::size_t pos = 0; pos < num_bits; ++pos) {
-            result += static_cast<int>(test(pos));
+        for (Block block : blocks) {
+            result += popcount(block);
+        }
+        return result;
+    }
+
+    // Count the number of bits set in this bitset but not in 'other'.
+    int count_difference(const DynamicBitset &other) const {
+        assert(size() == other.size());
+        int result = 0;
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            result += popcount(blocks[i] & ~other.blocks[i]);
+        }
+        return result;
+    }
+
+    // Count the number of bits set in both bitsets.
+    int count_intersection(const DynamicBitset &other) const {
+        assert(size() == other.size());
+        int result = 0;
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            result += popcount(blocks[i] & other.blocks[i]);
         }
         return result;
     }
@@ -127,6 +146,23 @@ public:
         return true;
     }
 
+    DynamicBitset &operator|=(const DynamicBitset &other) {
+        assert(size() == other.size());
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            blocks[i] |= other.blocks[i];
+        }
+        return *this;
+    }
+
+    // Set difference, i.e., reset all bits set in 'other'.
+    DynamicBitset &operator-=(const DynamicBitset &other) {
+        assert(size() == other.size());
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            blocks[i] &= ~other.blocks[i];
+        }
+        return *this;
+    }
+
     template<typename B>
     friend bool operator==(
         const dynamic_bitset::DynamicBitset<B>& a,
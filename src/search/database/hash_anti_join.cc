@@ -0,0 +1,50 @@
+#include "hash_anti_join.h"
+#include "../hash_structures.h"
+#include "table.h"
+#include "utils.h"
+
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+size_t hash_anti_join(Table &t1, const Table &t2) {
+    if (t2.tuples.empty()) {
+        return t1.tuples.size();
+    }
+
+    auto matches = compute_matching_columns(t1, t2);
+
+    if (matches.empty()) {
+        /*
+         * If no attribute matches, then t2 contains a ground atom that holds
+         */
+        t1.tuples.clear();
+        return 0;
+    }
+
+    unordered_set<vector<int>, TupleHash> keys;
+    // Build phase
+    for (const vector<int> &tuple : t2.tuples) {
+        vector<int> key(matches.size());
+        for (size_t i = 0; i < matches.size(); i++) {
+            key[i] = tuple[matches[i].second];
+        }
+        keys.insert(move(key));
+    }
+
+    // Probe phase: keep only the tuples without any match
+    vector<vector<int>> new_tuples;
+    vector<int> key(matches.size());
+    for (vector<int> &tuple : t1.tuples) {
+        for (size_t i = 0; i < matches.size(); i++) {
+            key[i] = tuple[matches[i].first];
+        }
+        if (keys.count(key) == 0) {
+            new_tuples.push_back(move(tuple));
+        }
+    }
+    t1.tuples = std::move(new_tuples);
+    return t1.tuples.size();
+}
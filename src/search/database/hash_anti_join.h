@@ -0,0 +1,27 @@
+#ifndef SEARCH_HASH_ANTI_JOIN_H
+#define SEARCH_HASH_ANTI_JOIN_H
+
+#include <cstddef>
+
+class Table;
+
+/**
+ * @brief Anti-join (NOT EXISTS) two tables using a hash-based approach. Result is
+ * written in the table passed as first parameter.
+ *
+ * @details Only the tuples of t1 that do not match any tuple of t2 on the common
+ * attributes are kept. Every variable of t2 must also occur in t1, i.e., the
+ * anti-join is only applied once all variables of t2 are bound, and the
+ * constant positions of t2 must have been selected beforehand. Hence, if no
+ * attribute matches, t2 is either empty (and t1 is kept as it is) or it
+ * contains a ground atom that holds (and t1 becomes empty).
+ *
+ * @see hash_semi_join.h
+ *
+ * @param t1: Working table. Table on the left of the anti-join.
+ * @param t2: Table on the right of the anti-join.
+ * @return Size of the working table.
+ */
+std::size_t hash_anti_join(Table &t1, const Table &t2);
+
+#endif //SEARCH_HASH_ANTI_JOIN_H
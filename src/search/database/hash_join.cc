@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <unordered_map>
 
 using namespace std;
@@ -21,7 +22,64 @@ std::vector<int> project_tuple(
     return projected;
 }
 
+/*
+ * Position of the inequality variables in the tuples being joined. If 'from_t1'
+ * is true, the value is taken from the tuple of t1, otherwise from the tuple of t2.
+ */
+struct InequalityColumns {
+    bool from_t1_first, from_t1_second;
+    int first, second;
+
+    bool satisfied(const vector<int> &tuple_t1, const vector<int> &tuple_t2) const {
+        int v1 = from_t1_first ? tuple_t1[first] : tuple_t2[first];
+        int v2 = from_t1_second ? tuple_t1[second] : tuple_t2[second];
+        return v1 != v2;
+    }
+};
+
+/*
+ * Compute the inequalities that become checkable in this join, i.e., those
+ * with both variables bound in the result but not in any of the two tables
+ * alone (which are assumed to be already consistent with them).
+ */
+static vector<InequalityColumns> compute_inequality_columns(
+    const Table &t1, const Table &t2, const vector<pair<int, int>> &inequalities)
+{
+    vector<InequalityColumns> columns;
+    const auto &idx1 = t1.tuple_index;
+    const auto &idx2 = t2.tuple_index;
+    for (const pair<int, int> &ineq : inequalities) {
+        auto a1 = find(idx1.begin(), idx1.end(), ineq.first);
+        auto b1 = find(idx1.begin(), idx1.end(), ineq.second);
+        auto a2 = find(idx2.begin(), idx2.end(), ineq.first);
+        auto b2 = find(idx2.begin(), idx2.end(), ineq.second);
+        bool bound_in_t1 = (a1 != idx1.end() and b1 != idx1.end());
+        bool bound_in_t2 = (a2 != idx2.end() and b2 != idx2.end());
+        if (bound_in_t1 or bound_in_t2 or
+            (a1 == idx1.end() and a2 == idx2.end()) or
+            (b1 == idx1.end() and b2 == idx2.end())) {
+            continue;
+        }
+        InequalityColumns c;
+        c.from_t1_first = (a1 != idx1.end());
+        c.from_t1_second = (b1 != idx1.end());
+        c.first = c.from_t1_first ? distance(idx1.begin(), a1) : distance(idx2.begin(), a2);
+        c.second = c.from_t1_second ? distance(idx1.begin(), b1) : distance(idx2.begin(), b2);
+        columns.push_back(c);
+    }
+    return columns;
+}
+
 void hash_join(Table &t1, const Table &t2) {
+    hash_join(t1, t2, vector<pair<int, int>>());
+}
+
+void hash_join(Table &t1, const Table &t2, const std::vector<std::pair<int, int>> &inequalities) {
+    hash_join(t1, t2, inequalities, numeric_limits<size_t>::max());
+}
+
+bool hash_join(Table &t1, const Table &t2, const std::vector<std::pair<int, int>> &inequalities,
+               size_t max_tuples) {
     /*
      * This function implements a hash join as follows
      *
@@ -30,11 +88,25 @@ void hash_join(Table &t1, const Table &t2) {
      * 3. Otherwise, we loop over the first table, create a hash over the
      *    matching keys. Then, loop over the second table searching for hits
      *    in the hash table.
+     *
+     * In both cases, pairs of tuples violating some inequality are discarded
+     * before the joined tuple is created, and the join stops as soon as more
+     * than max_tuples tuples are created.
      */
     std::vector<int> matches1, matches2;
     compute_matching_columns(t1, t2, matches1, matches2);
     assert(matches1.size()==matches2.size());
 
+    const vector<InequalityColumns> ineq_columns =
+        compute_inequality_columns(t1, t2, inequalities);
+    auto consistent = [&ineq_columns](const vector<int> &tuple_t1, const vector<int> &tuple_t2) {
+        for (const InequalityColumns &c : ineq_columns) {
+            if (!c.satisfied(tuple_t1, tuple_t2))
+                return false;
+        }
+        return true;
+    };
+
     vector<vector<int>> new_tuples;
     if (matches1.empty()) {
         /*
@@ -44,9 +116,15 @@ void hash_join(Table &t1, const Table &t2) {
         t1.tuple_index.insert(t1.tuple_index.end(), t2.tuple_index.begin(), t2.tuple_index.end());
         for (const vector<int> &tuple_t1 : t1.tuples) {
             for (const vector<int> &tuple_t2 : t2.tuples) {
+                if (!consistent(tuple_t1, tuple_t2))
+                    continue;
                 vector<int> aux(tuple_t1);
                 aux.insert(aux.end(), tuple_t2.begin(), tuple_t2.end());
                 new_tuples.push_back(std::move(aux));
+                if (new_tuples.size() > max_tuples) {
+                    t1.tuples = std::move(new_tuples);
+                    return false;
+                }
             }
         }
     }
@@ -70,21 +148,29 @@ void hash_join(Table &t1, const Table &t2) {
         }
 
         // Probe phase
-        for (vector<int> tuple : t2.tuples) {
+        for (const vector<int> &tuple : t2.tuples) {
 
             auto it = hash_join_map.find(project_tuple(tuple, matches2));
 
             if (it != hash_join_map.end()) {
                 const auto& matching_tuples = it->second;
-                for (vector<int> t:matching_tuples) {
+                for (const vector<int> &m : matching_tuples) {
+                    if (!consistent(m, tuple))
+                        continue;
+                    vector<int> t(m);
                     for (unsigned j = 0; j < to_remove.size(); ++j) {
                         if (!to_remove[j]) t.push_back(tuple[j]);
                     }
                     new_tuples.push_back(std::move(t));
+                    if (new_tuples.size() > max_tuples) {
+                        t1.tuples = std::move(new_tuples);
+                        return false;
+                    }
                 }
             }
         }
 
     }
     t1.tuples = std::move(new_tuples);
+    return true;
 }
@@ -1,6 +1,10 @@
 #ifndef SEARCH_HASH_JOIN_H
 #define SEARCH_HASH_JOIN_H
 
+#include <cstddef>
+#include <utility>
+#include <vector>
+
 class Table;
 
 /**
@@ -16,4 +20,26 @@ class Table;
  */
 void hash_join(Table &t1, const Table &t2);
 
+/**
+ * @brief Hash join two tables, discarding the joined tuples violating some inequality.
+ *
+ * @details Only the inequalities that become fully bound in this join are checked, i.e.,
+ * those whose two variables are in the result but not both in t1 or both in t2. The
+ * column offsets of these inequalities are computed once, and they are evaluated in the
+ * probe loop, so tuples violating them are never materialised. The input tables are
+ * assumed to be consistent with the inequalities over their own variables.
+ *
+ * @param inequalities: pairs of (parameter) indices that must take different values.
+ */
+void hash_join(Table &t1, const Table &t2, const std::vector<std::pair<int, int>> &inequalities);
+
+/**
+ * @brief Hash join two tables with inequalities, stopping once the result has more
+ * than max_tuples tuples.
+ *
+ * @return false if the limit was exceeded, in which case t1 holds an incomplete result.
+ */
+bool hash_join(Table &t1, const Table &t2, const std::vector<std::pair<int, int>> &inequalities,
+               std::size_t max_tuples);
+
 #endif //SEARCH_HASH_JOIN_H
@@ -4,6 +4,7 @@
 #include "heuristic.h"
 
 #include "../task.h"
+#include "../states/extensional_states.h"
 
 /**
  * @brief Evaluates all states with h=1. Does not perform goal check.
@@ -17,6 +18,16 @@ public:
         if (task.is_goal(s)) return 0;
         return 1;
     }
+
+    bool supports_extensional_states() const override {
+        return true;
+    }
+
+    int compute_heuristic_packed(const ExtensionalPackedState &s,
+                                 const ExtensionalStatePacker &packer) override {
+        if (packer.is_goal(s)) return 0;
+        return 1;
+    }
 };
 
 #endif //SEARCH_BLIND_HEURISTIC_H
@@ -1,6 +1,7 @@
 
 #include "goalcount.h"
 #include "../task.h"
+#include "../states/extensional_states.h"
 
 #include <cassert>
 
@@ -23,6 +24,10 @@ int Goalcount::compute_heuristic(const DBState &s, const Task &task) {
     return h;
 }
 
+int Goalcount::compute_heuristic_packed(const ExtensionalPackedState &s,
+                                        const ExtensionalStatePacker &packer) {
+    return packer.count_unsatisfied_goals(s);
+}
 
 bool Goalcount::atom_not_satisfied(const DBState &s,
                                    const AtomicGoal &atomicGoal) const {
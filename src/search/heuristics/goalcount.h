@@ -20,6 +20,14 @@ public:
 
     int compute_heuristic(const DBState & s, const Task& task) final;
 
+    bool supports_extensional_states() const final {
+        return true;
+    }
+
+    //! Number of goal atoms in the mask of the packer that are not satisfied
+    int compute_heuristic_packed(const ExtensionalPackedState &s,
+                                 const ExtensionalStatePacker &packer) final;
+
 private:
   static int compute_unreached_nullary_atoms(const std::unordered_set<int> &positive,
                                              const std::unordered_set<int> &negative,
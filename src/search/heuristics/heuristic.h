@@ -11,6 +11,8 @@
 const int UNSOLVABLE_STATE = std::numeric_limits<int>::max();
 
 class DBState;
+class ExtensionalPackedState;
+class ExtensionalStatePacker;
 class Task;
 
 class Heuristic {
@@ -32,6 +34,21 @@ public:
      */
     virtual int compute_heuristic(const DBState &s, const Task &task) = 0;
 
+    //! True if the heuristic can be computed without unpacking extensional states
+    virtual bool supports_extensional_states() const {
+        return false;
+    }
+
+    /**
+     * @brief Compute the heuristic directly on a state of the extensional representation
+     * @note Only called if supports_extensional_states() is true
+     */
+    virtual int compute_heuristic_packed(const ExtensionalPackedState &,
+                                         const ExtensionalStatePacker &) {
+        std::cerr << "Heuristic does not support packed extensional states" << std::endl;
+        exit(-1);
+    }
+
     const std::map<int, std::vector<GroundAtom>> &get_useful_atoms() const {
         return useful_atoms;
     }
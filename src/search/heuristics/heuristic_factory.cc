@@ -12,9 +12,13 @@
 
 Heuristic *HeuristicFactory::create(const Options &opt, const Task &task)
 {
-    const std::string& method = opt.get_evaluator();
+    return create(opt.get_evaluator(), opt, task);
+}
+
+Heuristic *HeuristicFactory::create(const std::string &method, const Options &opt, const Task &task)
+{
     std::ifstream datalog_file(opt.get_datalog_file());
-    if (!datalog_file and ((opt.get_evaluator() == "add") or (opt.get_evaluator() == "hmax"))) {
+    if (!datalog_file and ((method == "add") or (method == "hmax"))) {
         std::cerr << "Error opening the Datalog model file: " << opt.get_datalog_file() << std::endl;
         exit(-1);
     }
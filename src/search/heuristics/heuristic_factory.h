@@ -14,6 +14,9 @@ class Heuristic;
 class HeuristicFactory {
 public:
     static Heuristic *create(const Options &opt, const Task &task);
+
+    //! Create the heuristic with the given name instead of the evaluator of the options
+    static Heuristic *create(const std::string &method, const Options &opt, const Task &task);
 };
 
 #endif //SEARCH_HEURISTIC_FACTORY_H
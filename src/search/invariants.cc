@@ -0,0 +1,480 @@
+#include "invariants.h"
+
+#include "action_schema.h"
+#include "task.h"
+
+#include "utils/timer.h"
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <set>
+
+using namespace std;
+
+static const size_t MAX_CANDIDATES = 100000;
+
+GroundAtom InvariantPart::get_instance(const GroundAtom &atom) const
+{
+    GroundAtom instance;
+    instance.reserve(order.size());
+    for (int position : order)
+        instance.push_back(atom[position]);
+    return instance;
+}
+
+vector<Argument> InvariantPart::get_instance(const vector<Argument> &arguments) const
+{
+    vector<Argument> instance;
+    instance.reserve(order.size());
+    for (int position : order)
+        instance.push_back(arguments[position]);
+    return instance;
+}
+
+Invariant::Invariant(vector<InvariantPart> parts) : parts(move(parts))
+{
+    sort(this->parts.begin(), this->parts.end(),
+         [](const InvariantPart &a, const InvariantPart &b) { return a.predicate < b.predicate; });
+}
+
+const InvariantPart *Invariant::find_part(int predicate) const
+{
+    auto it = lower_bound(parts.begin(), parts.end(), predicate,
+                          [](const InvariantPart &part, int p) { return part.predicate < p; });
+    if (it == parts.end() or it->predicate != predicate)
+        return nullptr;
+    return &*it;
+}
+
+static bool same_term(const Argument &a, const Argument &b)
+{
+    return a.constant == b.constant and a.index == b.index;
+}
+
+static bool same_terms(const vector<Argument> &a, const vector<Argument> &b)
+{
+    return equal(a.begin(), a.end(), b.begin(), b.end(), same_term);
+}
+
+/*
+ * Positive preconditions and effects of an action schema, where nullary atoms are
+ * literals without arguments.
+ */
+struct Literal {
+    int predicate;
+    vector<Argument> arguments;
+};
+
+struct SchemaLiterals {
+    vector<Literal> preconditions;
+    vector<Literal> adds;
+    vector<Literal> deletes;
+    vector<pair<Argument, Argument>> inequalities;
+
+    explicit SchemaLiterals(const ActionSchema &action) {
+        for (const Atom &atom : action.get_precondition()) {
+            if (atom.name == "=") {
+                if (atom.negated)
+                    inequalities.emplace_back(atom.arguments[0], atom.arguments[1]);
+            }
+            else if (!atom.negated) {
+                preconditions.push_back({atom.predicate_symbol, atom.arguments});
+            }
+        }
+        for (const Atom &atom : action.get_effects()) {
+            if (atom.negated)
+                deletes.push_back({atom.predicate_symbol, atom.arguments});
+            else
+                adds.push_back({atom.predicate_symbol, atom.arguments});
+        }
+        add_nullary(action.get_positive_nullary_precond(), preconditions);
+        add_nullary(action.get_positive_nullary_effects(), adds);
+        add_nullary(action.get_negative_nullary_effects(), deletes);
+    }
+
+    static void add_nullary(const vector<bool> &atoms, vector<Literal> &literals) {
+        for (size_t p = 0; p < atoms.size(); ++p) {
+            if (atoms[p])
+                literals.push_back({int(p), {}});
+        }
+    }
+
+    bool is_precondition(const Literal &literal) const {
+        return any_of(preconditions.begin(), preconditions.end(), [&](const Literal &pre) {
+            return pre.predicate == literal.predicate and same_terms(pre.arguments, literal.arguments);
+        });
+    }
+
+    bool are_different(const Argument &a, const Argument &b) const {
+        if (a.constant and b.constant)
+            return a.index != b.index;
+        return any_of(inequalities.begin(), inequalities.end(), [&](const pair<Argument, Argument> &ineq) {
+            return (same_term(ineq.first, a) and same_term(ineq.second, b)) or
+                   (same_term(ineq.first, b) and same_term(ineq.second, a));
+        });
+    }
+
+    bool may_unify(const vector<Argument> &a, const vector<Argument> &b) const {
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (are_different(a[i], b[i]))
+                return false;
+        }
+        return true;
+    }
+};
+
+class InvariantSynthesis {
+    const Task &task;
+    vector<SchemaLiterals> schemas;
+    vector<bool> is_fluent;
+
+    deque<vector<InvariantPart>> queue;
+    set<vector<int>> seen;
+
+    static vector<int> get_key(const vector<InvariantPart> &parts) {
+        vector<int> key;
+        for (const InvariantPart &part : parts) {
+            key.push_back(part.predicate);
+            key.push_back(part.omitted_position);
+            key.insert(key.end(), part.order.begin(), part.order.end());
+            key.push_back(-2);
+        }
+        return key;
+    }
+
+    void enqueue(vector<InvariantPart> parts) {
+        sort(parts.begin(), parts.end(),
+             [](const InvariantPart &a, const InvariantPart &b) { return a.predicate < b.predicate; });
+        if (seen.size() < MAX_CANDIDATES and seen.insert(get_key(parts)).second)
+            queue.push_back(move(parts));
+    }
+
+    static const InvariantPart *find_part(const vector<InvariantPart> &parts, int predicate) {
+        for (const InvariantPart &part : parts) {
+            if (part.predicate == predicate)
+                return &part;
+        }
+        return nullptr;
+    }
+
+    /*
+     * Add a candidate for each delete effect of the schema that is a precondition and
+     * could balance the add effect with a new part.
+     */
+    void refine(const vector<InvariantPart> &parts, const SchemaLiterals &schema,
+                const vector<Argument> &instance) {
+        for (const Literal &del : schema.deletes) {
+            if (!is_fluent[del.predicate] or find_part(parts, del.predicate) or
+                !schema.is_precondition(del))
+                continue;
+            vector<int> order;
+            vector<bool> used(del.arguments.size(), false);
+            for (const Argument &term : instance) {
+                for (size_t i = 0; i < del.arguments.size(); ++i) {
+                    if (!used[i] and same_term(del.arguments[i], term)) {
+                        used[i] = true;
+                        order.push_back(i);
+                        break;
+                    }
+                }
+            }
+            if (order.size() != instance.size())
+                continue;
+            int omitted_position = -1;
+            size_t number_omitted = count(used.begin(), used.end(), false);
+            if (number_omitted > 1)
+                continue;
+            if (number_omitted == 1)
+                omitted_position = find(used.begin(), used.end(), false) - used.begin();
+
+            vector<InvariantPart> refined = parts;
+            refined.emplace_back(del.predicate, move(order), omitted_position);
+            enqueue(move(refined));
+        }
+    }
+
+    bool is_balanced(const vector<InvariantPart> &parts, const SchemaLiterals &schema,
+                     const vector<Argument> &instance) const {
+        for (const Literal &del : schema.deletes) {
+            const InvariantPart *part = find_part(parts, del.predicate);
+            if (part and same_terms(part->get_instance(del.arguments), instance) and
+                schema.is_precondition(del))
+                return true;
+        }
+        return false;
+    }
+
+    /*
+     * Return true if the schema cannot be applicable in a state satisfying the
+     * candidate when the two instances are equal, i.e., if equating their terms makes
+     * two constants equal, violates an inequality, or puts two preconditions of
+     * different parts in the same instance of the candidate.
+     */
+    static bool is_unification_inconsistent(const vector<InvariantPart> &parts,
+                                            const SchemaLiterals &schema,
+                                            const vector<Argument> &a,
+                                            const vector<Argument> &b) {
+        map<pair<bool, int>, pair<bool, int>> parent;
+        auto find = [&](const Argument &t) {
+            pair<bool, int> key(t.constant, t.index);
+            auto it = parent.find(key);
+            while (it != parent.end() and it->second != key) {
+                key = it->second;
+                it = parent.find(key);
+            }
+            return key;
+        };
+        for (size_t i = 0; i < a.size(); ++i) {
+            pair<bool, int> root_a = find(a[i]), root_b = find(b[i]);
+            if (root_a == root_b)
+                continue;
+            if (root_a.first and root_b.first)
+                return true;
+            // Constants are always the representative of their class
+            if (root_a.first)
+                swap(root_a, root_b);
+            parent[root_a] = root_b;
+        }
+        for (const auto &ineq : schema.inequalities) {
+            if (find(ineq.first) == find(ineq.second))
+                return true;
+        }
+
+        auto representatives = [&](const vector<Argument> &terms) {
+            vector<pair<bool, int>> result;
+            for (const Argument &t : terms)
+                result.push_back(find(t));
+            return result;
+        };
+        const vector<Literal> &pre = schema.preconditions;
+        for (size_t i = 0; i < pre.size(); ++i) {
+            const InvariantPart *part1 = find_part(parts, pre[i].predicate);
+            if (!part1)
+                continue;
+            for (size_t j = i + 1; j < pre.size(); ++j) {
+                const InvariantPart *part2 = find_part(parts, pre[j].predicate);
+                if (part2 and part1 != part2 and
+                    representatives(part1->get_instance(pre[i].arguments)) ==
+                    representatives(part2->get_instance(pre[j].arguments)))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    bool is_invariant(const vector<InvariantPart> &parts) {
+        for (const SchemaLiterals &schema : schemas) {
+            vector<vector<Argument>> add_instances;
+            for (const Literal &add : schema.adds) {
+                const InvariantPart *part = find_part(parts, add.predicate);
+                if (part)
+                    add_instances.push_back(part->get_instance(add.arguments));
+            }
+            for (size_t i = 0; i < add_instances.size(); ++i) {
+                for (size_t j = i + 1; j < add_instances.size(); ++j) {
+                    if (schema.may_unify(add_instances[i], add_instances[j]) and
+                        !is_unification_inconsistent(parts, schema, add_instances[i], add_instances[j]))
+                        return false;
+                }
+            }
+            for (const vector<Argument> &instance : add_instances) {
+                if (!is_balanced(parts, schema, instance)) {
+                    refine(parts, schema, instance);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool holds_in_initial_state(const vector<InvariantPart> &parts) const {
+        const DBState &init = task.initial_state;
+        set<GroundAtom> instances;
+        for (const InvariantPart &part : parts) {
+            if (task.nullary_predicates.count(part.predicate)) {
+                if (init.get_nullary_atoms()[part.predicate] and !instances.insert(GroundAtom()).second)
+                    return false;
+                continue;
+            }
+            for (const GroundAtom &atom : init.get_tuples_of_relation(part.predicate)) {
+                if (!instances.insert(part.get_instance(atom)).second)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    explicit InvariantSynthesis(const Task &task) : task(task), is_fluent(task.predicates.size()) {
+        for (const ActionSchema &action : task.actions)
+            schemas.emplace_back(action);
+        for (size_t p = 0; p < task.predicates.size(); ++p) {
+            const Predicate &predicate = task.predicates[p];
+            is_fluent[p] = !predicate.isStaticPredicate() and predicate.isRelevant() and
+                           predicate.getName() != "=";
+        }
+    }
+
+    vector<Invariant> run() {
+        for (size_t p = 0; p < task.predicates.size(); ++p) {
+            if (!is_fluent[p])
+                continue;
+            int arity = task.predicates[p].getArity();
+            for (int omitted = -1; omitted < arity; ++omitted) {
+                vector<int> order;
+                for (int i = 0; i < arity; ++i) {
+                    if (i != omitted)
+                        order.push_back(i);
+                }
+                enqueue({InvariantPart(p, move(order), omitted)});
+            }
+        }
+
+        vector<Invariant> invariants;
+        while (!queue.empty()) {
+            vector<InvariantPart> parts = move(queue.front());
+            queue.pop_front();
+            if (!is_invariant(parts) or !holds_in_initial_state(parts))
+                continue;
+            if (parts.size() == 1 and parts[0].omitted_position == -1)
+                continue;
+            invariants.emplace_back(move(parts));
+        }
+        return invariants;
+    }
+
+    size_t get_number_candidates() const {
+        return seen.size();
+    }
+};
+
+static void dump_invariant(const Task &task, const Invariant &invariant)
+{
+    cout << "Mutex group:";
+    for (const InvariantPart &part : invariant.get_parts()) {
+        int arity = part.order.size() + (part.omitted_position != -1);
+        vector<string> arguments(arity, "*");
+        for (size_t i = 0; i < part.order.size(); ++i)
+            arguments[part.order[i]] = "?x" + to_string(i);
+        cout << " " << task.predicates[part.predicate].getName() << "(";
+        for (int i = 0; i < arity; ++i)
+            cout << (i ? ", " : "") << arguments[i];
+        cout << ")";
+    }
+    cout << endl;
+}
+
+vector<Invariant> synthesize_invariants(const Task &task)
+{
+    utils::Timer timer;
+    InvariantSynthesis synthesis(task);
+    vector<Invariant> invariants = synthesis.run();
+    timer.stop();
+    for (const Invariant &invariant : invariants)
+        dump_invariant(task, invariant);
+    cout << "Found " << invariants.size() << " invariant(s) among "
+         << synthesis.get_number_candidates() << " candidate(s) in " << timer() << endl;
+    return invariants;
+}
+
+bool are_mutex(const vector<Invariant> &invariants,
+               int predicate1, const GroundAtom &atom1,
+               int predicate2, const GroundAtom &atom2)
+{
+    if (predicate1 == predicate2 and atom1 == atom2)
+        return false;
+    for (const Invariant &invariant : invariants) {
+        const InvariantPart *part1 = invariant.find_part(predicate1);
+        const InvariantPart *part2 = invariant.find_part(predicate2);
+        if (part1 and part2 and part1->get_instance(atom1) == part2->get_instance(atom2))
+            return true;
+    }
+    return false;
+}
+
+bool has_mutex_preconditions(const vector<Invariant> &invariants, const ActionSchema &action)
+{
+    SchemaLiterals schema(action);
+    const vector<Literal> &pre = schema.preconditions;
+    for (const Invariant &invariant : invariants) {
+        for (size_t i = 0; i < pre.size(); ++i) {
+            const InvariantPart *part1 = invariant.find_part(pre[i].predicate);
+            if (!part1)
+                continue;
+            for (size_t j = i + 1; j < pre.size(); ++j) {
+                const InvariantPart *part2 = invariant.find_part(pre[j].predicate);
+                if (!part2 or !same_terms(part1->get_instance(pre[i].arguments),
+                                          part2->get_instance(pre[j].arguments)))
+                    continue;
+                // Atoms of the same instance differ in the predicate or the counted variable
+                if (part1 != part2)
+                    return true;
+                int omitted = part1->omitted_position;
+                if (omitted != -1 and
+                    schema.are_different(pre[i].arguments[omitted], pre[j].arguments[omitted]))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+InvariantDeadEnds::InvariantDeadEnds(const Task &task)
+{
+    auto add_goal = [&](int predicate, const GroundAtom &goal) {
+        for (const Invariant &invariant : task.invariants) {
+            const InvariantPart *part = invariant.find_part(predicate);
+            if (part)
+                goal_instances.push_back({predicate, goal, &invariant, part->get_instance(goal)});
+        }
+    };
+    for (const AtomicGoal &goal : task.goal.goal) {
+        if (!goal.negated)
+            add_goal(goal.predicate, goal.args);
+    }
+    for (int predicate : task.goal.positive_nullary_goals)
+        add_goal(predicate, {});
+}
+
+bool InvariantDeadEnds::is_goal_true(const GoalInstance &g, const DBState &state)
+{
+    if (g.goal.empty())
+        return state.get_nullary_atoms()[g.predicate];
+    return state.get_tuples_of_relation(g.predicate).count(g.goal) > 0;
+}
+
+bool InvariantDeadEnds::is_instance_empty(const GoalInstance &g, const DBState &state)
+{
+    for (const InvariantPart &part : g.invariant->get_parts()) {
+        if (part.omitted_position == -1) {
+            // The instance determines the atom of this part
+            if (part.order.empty()) {
+                if (state.get_nullary_atoms()[part.predicate])
+                    return false;
+                continue;
+            }
+            GroundAtom atom(part.order.size());
+            for (size_t i = 0; i < part.order.size(); ++i)
+                atom[part.order[i]] = g.instance[i];
+            if (state.get_tuples_of_relation(part.predicate).count(atom))
+                return false;
+            continue;
+        }
+        for (const GroundAtom &atom : state.get_tuples_of_relation(part.predicate)) {
+            if (part.get_instance(atom) == g.instance)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool InvariantDeadEnds::is_dead_end(const DBState &state) const
+{
+    for (const GoalInstance &g : goal_instances) {
+        if (!is_goal_true(g, state) and is_instance_empty(g, state))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,129 @@
+#ifndef SEARCH_INVARIANTS_H
+#define SEARCH_INVARIANTS_H
+
+#include "structures.h"
+
+#include <vector>
+
+class ActionSchema;
+class DBState;
+class Task;
+
+/**
+ * @brief Part of an invariant over a single predicate.
+ *
+ * @var predicate: Predicate symbol of the atoms covered by this part.
+ * @var order: Argument positions of the atom holding the parameters of the invariant,
+ * in the order of the parameters.
+ * @var omitted_position: Argument position of the counted variable, or -1 if every
+ * argument is a parameter of the invariant.
+ */
+struct InvariantPart {
+    InvariantPart(int predicate, std::vector<int> order, int omitted_position)
+        : predicate(predicate), order(std::move(order)), omitted_position(omitted_position) {}
+
+    int predicate;
+    std::vector<int> order;
+    int omitted_position;
+
+    //! Parameters of the invariant instance the ground atom belongs to
+    GroundAtom get_instance(const GroundAtom &atom) const;
+
+    //! Parameters of the invariant instance the lifted atom belongs to
+    std::vector<Argument> get_instance(const std::vector<Argument> &arguments) const;
+};
+
+/**
+ * @brief Lifted mutex group: for every instantiation of its parameters, at most one
+ * atom of its parts is true in every reachable state.
+ *
+ * @details Parts are sorted by predicate, and there is at most one part per predicate.
+ * Nullary predicates are parts with an empty order.
+ */
+class Invariant {
+    std::vector<InvariantPart> parts;
+
+public:
+    explicit Invariant(std::vector<InvariantPart> parts);
+
+    const std::vector<InvariantPart> &get_parts() const {
+        return parts;
+    }
+
+    //! Return the part over the given predicate, or nullptr if there is none
+    const InvariantPart *find_part(int predicate) const;
+
+    std::size_t get_arity() const {
+        return parts[0].order.size();
+    }
+};
+
+/**
+ * @brief Lifted invariant synthesis based on monotonicity, following Helmert (AIJ
+ * 2009, Section 5). Return the mutex groups of the task that hold in its initial state.
+ *
+ * @details Every fluent predicate starts as a candidate with a single part, once
+ * without counted variable and once for each argument position as counted variable. A
+ * candidate is an invariant if no action schema can increase the number of true atoms
+ * of an instance:
+ *    1. No schema adds two atoms that might belong to the same instance (heavy
+ *    schemas).
+ *    2. Every add effect is balanced by a delete effect of the same instance whose atom
+ *    is also a precondition, so it is true whenever the schema is applicable.
+ * If an add effect is not balanced, we refine the candidate with a new part for each
+ * delete effect of the schema that is a precondition and would balance it. At most
+ * MAX_CANDIDATES candidates are considered. Checks are syntactic and hence
+ * conservative: two terms are only known to be equal if they are the same variable or
+ * constant, and only known to be different if they are different constants or an
+ * inequality of the schema separates them.
+ *
+ * Trivial invariants (a single part without counted variable) are discarded.
+ */
+std::vector<Invariant> synthesize_invariants(const Task &task);
+
+/**
+ * Return true if the two (different) ground atoms belong to the same instance of some
+ * invariant, so they are never true in the same reachable state.
+ */
+bool are_mutex(const std::vector<Invariant> &invariants,
+               int predicate1, const GroundAtom &atom1,
+               int predicate2, const GroundAtom &atom2);
+
+/**
+ * Return true if two positive preconditions of the schema belong to the same invariant
+ * instance and are different atoms for every instantiation, so the schema is never
+ * applicable in a reachable state.
+ */
+bool has_mutex_preconditions(const std::vector<Invariant> &invariants, const ActionSchema &action);
+
+/**
+ * @brief Detect dead ends from the goal atoms covered by some invariant.
+ *
+ * @details Every add effect of an invariant atom deletes an atom of the same instance
+ * which is true before, so an instance without true atoms stays empty forever. A state
+ * is a dead end if some goal atom is false and its instance is empty.
+ */
+class InvariantDeadEnds {
+    struct GoalInstance {
+        int predicate;
+        GroundAtom goal;
+        const Invariant *invariant;
+        GroundAtom instance;
+    };
+
+    std::vector<GoalInstance> goal_instances;
+
+    static bool is_goal_true(const GoalInstance &g, const DBState &state);
+    static bool is_instance_empty(const GoalInstance &g, const DBState &state);
+
+public:
+    explicit InvariantDeadEnds(const Task &task);
+
+    bool empty() const {
+        return goal_instances.empty();
+    }
+
+    bool is_dead_end(const DBState &state) const;
+};
+
+#endif //SEARCH_INVARIANTS_H
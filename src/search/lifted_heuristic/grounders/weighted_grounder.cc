@@ -6,100 +6,204 @@
 #include "../rules/product.h"
 #include "../rules/project.h"
 
+#include <algorithm>
 #include <deque>
 #include <limits>
 #include <vector>
 
+#include <boost/functional/hash.hpp>
+
 using namespace std;
 
 namespace lifted_heuristic {
 
+size_t ReachedFactIndices::Hash::operator()(int index) const {
+    size_t seed = 0;
+    if (index == PROBE) {
+        for (const Term &t : facts->probe->get_arguments())
+            boost::hash_combine(seed, t.get_index());
+        boost::hash_combine(seed, facts->probe->get_predicate_index());
+    } else {
+        for (int object : facts->lp->get_fact_arguments(index))
+            boost::hash_combine(seed, object);
+        boost::hash_combine(seed, facts->lp->get_fact_predicate(index));
+    }
+    return seed;
+}
+
+bool ReachedFactIndices::Equal::operator()(int a, int b) const {
+    const LogicProgram &lp = *facts->lp;
+    if (a == b)
+        return true;
+    if (a != PROBE and b != PROBE) {
+        IndexRange arguments_a = lp.get_fact_arguments(a);
+        IndexRange arguments_b = lp.get_fact_arguments(b);
+        return lp.get_fact_predicate(a) == lp.get_fact_predicate(b) and
+               equal(arguments_a.begin(), arguments_a.end(), arguments_b.begin(), arguments_b.end());
+    }
+    const Fact &f = *facts->probe;
+    int index = (a == PROBE) ? b : a;
+    if (f.get_predicate_index() != lp.get_fact_predicate(index))
+        return false;
+    IndexRange arguments = lp.get_fact_arguments(index);
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (f.argument(i).get_index() != arguments[i])
+            return false;
+    }
+    return true;
+}
+
+int ReachedFactIndices::find(const Fact &f) {
+    probe = &f;
+    auto it = indices.find(PROBE);
+    probe = nullptr;
+    return (it == indices.end()) ? -1 : *it;
+}
+
 int WeightedGrounder::ground(LogicProgram &lp, int goal_predicate) {
-    unordered_set<Fact> reached_facts;
-    std::vector<Fact> newfacts;
+    if (use_layered_grounding)
+        return ground_in_layers(lp, goal_predicate);
+
+    reached_facts.reset(lp);
     q.clear();
     best_achievers.clear();
     facts_in_edb.clear();
 
-    for (const Fact &f : lp.get_facts()) {
-        q.push(f.get_cost(), f.get_fact_index());
-        facts_in_edb.insert(f.get_fact_index());
-        reached_facts.insert(f);
+    for (int id = 0, n = lp.get_number_of_facts(); id < n; ++id) {
+        q.push(lp.get_fact_cost(id), id);
+        facts_in_edb.insert(id);
+        reached_facts.insert(id);
     }
     while (!q.empty()) {
         pair<int, int> queue_top = q.pop();
         int cost = queue_top.first;
         int top_fact_index = queue_top.second;
-        const Fact current_fact = lp.get_fact_by_index(top_fact_index);
-        //current_fact.print_atom(lp.get_objects(), lp.get_map_index_to_atom());
-        //cout << " " << current_fact.get_cost() << endl;
-        if (current_fact.get_predicate_index() == goal_predicate) {
-            compute_best_achievers(current_fact, lp);
+        if (lp.get_fact_predicate(top_fact_index) == goal_predicate) {
+            compute_best_achievers(top_fact_index, lp);
             /*for (auto &a : best_achievers) {
-                const Fact &f = lp.get_fact_by_index(a);
-                f.print_atom(lp.get_objects(), lp.get_map_index_to_atom());
+                lp.get_fact_by_index(a).print_atom(lp.get_objects(), lp.get_map_index_to_atom());
                 cout << endl;
             }*/
             //exit(1);
-            return current_fact.get_cost();
+            return lp.get_fact_cost(top_fact_index);
         }
-        if (current_fact.get_cost() < cost) {
+        if (lp.get_fact_cost(top_fact_index) < cost) {
             continue;
         }
-        int predicate_index = current_fact.get_predicate_index();
-        for (const auto
-                &m : rule_matcher.get_matched_rules(predicate_index)) {
-            int rule_index = m.get_rule();
-            int position_in_the_body = m.get_position();
-            RuleBase &rule = lp.get_rule_by_index(rule_index);
-
-            assert(rule.get_type()==PROJECT || rule.get_type() == JOIN || rule.get_type() == PRODUCT);
-
-            newfacts.clear();
-            if (rule.get_type()==PROJECT) {
-                // Projection rule - single condition in the body
-                assert(position_in_the_body==0);
-                project(rule, current_fact, newfacts);
-            } else if (rule.get_type()==JOIN) {
-                // Join rule - two conditions in the body
-                assert(position_in_the_body <= 1);
-                join(rule, current_fact, position_in_the_body, newfacts);
-            } else {
-                // Product rule - more than one condition without shared free vars
-                product(rule, current_fact, position_in_the_body, newfacts);
-            }
+        expand(lp.get_fact_by_index(top_fact_index), lp, [&](int id, int new_cost) {
+            q.push(new_cost, id);
+        });
+    }
+    return std::numeric_limits<int>::max();
+}
 
-            // Note: using for loop for performance reasons, this is a heavily used loop
-            for (unsigned i=0, sz=newfacts.size(); i < sz; ++i) {
-                auto& new_fact = newfacts[i];
-                int id = is_cheapest_path_to_achieve_fact(new_fact, reached_facts, lp);
-                if (id!=HAS_CHEAPER_PATH) {
-                    q.push(new_fact.get_cost(), id);
-                }
+/*
+ * Same as 'ground', but instead of using a priority queue, the facts are
+ * processed in layers of increasing cost. Each layer is a plain vector where
+ * facts reached by rules of weight 0 are appended while the layer is being
+ * processed. A fact is only added to a layer when its cost improves, so every
+ * fact appears at most once per layer, and entries of facts that were already
+ * expanded in a cheaper layer are skipped without looking at the fact.
+ *
+ * This is only used if all rule weights are small (e.g., unit-cost tasks or
+ * h-max), so that the number of layers stays close to the heuristic value.
+ */
+int WeightedGrounder::ground_in_layers(LogicProgram &lp, int goal_predicate) {
+    reached_facts.reset(lp);
+    for (auto &layer : layers)
+        layer.clear();
+    expanded.assign(lp.get_number_of_facts(), false);
+    best_achievers.clear();
+    facts_in_edb.clear();
+
+    auto add_to_layer = [&](int id, int cost) {
+        if (size_t(cost) >= layers.size())
+            layers.resize(cost + 1);
+        layers[cost].push_back(id);
+    };
+
+    for (int id = 0, n = lp.get_number_of_facts(); id < n; ++id) {
+        add_to_layer(id, lp.get_fact_cost(id));
+        facts_in_edb.insert(id);
+        reached_facts.insert(id);
+    }
+    for (size_t cost = 0; cost < layers.size(); ++cost) {
+        // Do not keep a reference to the layer: it might be reallocated
+        for (size_t i = 0; i < layers[cost].size(); ++i) {
+            int id = layers[cost][i];
+            if (expanded[id])
+                continue;
+            expanded[id] = true;
+            if (lp.get_fact_predicate(id) == goal_predicate) {
+                compute_best_achievers(id, lp);
+                return lp.get_fact_cost(id);
             }
+            expand(lp.get_fact_by_index(id), lp, [&](int new_id, int new_cost) {
+                if (size_t(new_id) >= expanded.size())
+                    expanded.resize(new_id + 1, false);
+                add_to_layer(new_id, max<int>(new_cost, cost));
+            });
         }
     }
     return std::numeric_limits<int>::max();
 }
 
-int WeightedGrounder::is_cheapest_path_to_achieve_fact(Fact &new_fact,
-                                                       unordered_set<Fact> &reached_facts,
-                                                       LogicProgram &lp) {
-    const auto& it = reached_facts.find(new_fact);
+/*
+ * Apply all rules where the predicate of the fact occurs in the body and call
+ * 'push' with the index and cost of every fact reached with a lower cost.
+ */
+template<typename PushFunction>
+void WeightedGrounder::expand(const FactView &current_fact,
+                              LogicProgram &lp,
+                              const PushFunction &push) {
+    int predicate_index = current_fact.get_predicate_index();
+    for (const auto
+            &m : rule_matcher.get_matched_rules(predicate_index)) {
+        int rule_index = m.get_rule();
+        int position_in_the_body = m.get_position();
+        RuleBase &rule = lp.get_rule_by_index(rule_index);
+
+        assert(rule.get_type()==PROJECT || rule.get_type() == JOIN || rule.get_type() == PRODUCT);
+
+        newfacts.clear();
+        if (rule.get_type()==PROJECT) {
+            // Projection rule - single condition in the body
+            assert(position_in_the_body==0);
+            project(rule, current_fact, newfacts);
+        } else if (rule.get_type()==JOIN) {
+            // Join rule - two conditions in the body
+            assert(position_in_the_body <= 1);
+            join(lp, rule, current_fact, position_in_the_body, newfacts);
+        } else {
+            // Product rule - more than one condition without shared free vars
+            product(lp, rule, current_fact, position_in_the_body, newfacts);
+        }
+
+        // Note: using for loop for performance reasons, this is a heavily used loop
+        for (unsigned i=0, sz=newfacts.size(); i < sz; ++i) {
+            auto& new_fact = newfacts[i];
+            int id = is_cheapest_path_to_achieve_fact(new_fact, lp);
+            if (id!=HAS_CHEAPER_PATH) {
+                push(id, new_fact.get_cost());
+            }
+        }
+    }
+}
+
+int WeightedGrounder::is_cheapest_path_to_achieve_fact(Fact &new_fact, LogicProgram &lp) {
+    int index = reached_facts.find(new_fact);
 
-    if (it == reached_facts.end()) {  // The fact wasn't reached yet
+    if (index == -1) {  // The fact wasn't reached yet
         new_fact.set_fact_index();
-        reached_facts.insert(new_fact);
         lp.insert_fact(new_fact);
+        reached_facts.insert(new_fact.get_fact_index());
         return new_fact.get_fact_index();
     }
     else {
-        if (new_fact.get_cost() < it->get_cost()) {
-            new_fact.update_fact_index(it->get_fact_index());
-            reached_facts.erase(it);
-            reached_facts.insert(new_fact);
-            lp.update_fact_cost(new_fact.get_fact_index(), new_fact.get_cost());
-            return new_fact.get_fact_index();
+        if (new_fact.get_cost() < lp.get_fact_cost(index)) {
+            new_fact.update_fact_index(index);
+            lp.update_fact_cost(index, new_fact.get_cost());
+            return index;
         }
     }
     return HAS_CHEAPER_PATH;
@@ -116,7 +220,7 @@ int WeightedGrounder::is_cheapest_path_to_achieve_fact(Fact &new_fact,
  *
  */
 
-void WeightedGrounder::project(const RuleBase &rule_, const Fact &fact, std::vector<Fact>& newfacts) {
+void WeightedGrounder::project(const RuleBase &rule_, const FactView &fact, std::vector<Fact>& newfacts) {
     const ProjectRule &rule = static_cast<const ProjectRule &>(rule_);
 
     // New arguments start as a copy of the head atom and we just replace the
@@ -128,7 +232,7 @@ void WeightedGrounder::project(const RuleBase &rule_, const Fact &fact, std::vec
         const auto a = args[i];
         if (args.is_object(i)) {
             // Constant instead of free var
-            if (fact.argument(i)!=a) {
+            if (fact.argument(i)!=a.get_index()) {
                 // constants do not match!
                 return;
             }
@@ -136,7 +240,7 @@ void WeightedGrounder::project(const RuleBase &rule_, const Fact &fact, std::vec
             int pos = rule.get_head_position_of_arg(a);
             if (pos!=-1) {
                 // Variable should NOT be projected away by this rule
-                new_arguments.set_term_to_object(pos, fact.argument(i).get_index());
+                new_arguments.set_term_to_object(pos, fact.argument(i));
             }
         }
     }
@@ -167,18 +271,18 @@ void WeightedGrounder::project(const RuleBase &rule_, const Fact &fact, std::vec
  * The function returns a list of actions.
  *
  */
-void WeightedGrounder::join(
-        RuleBase &rule_, const Fact &fact, int position, std::vector<Fact>& newfacts) {
+void WeightedGrounder::join(const LogicProgram &lp,
+        RuleBase &rule_, const FactView &fact, int position, std::vector<Fact>& newfacts) {
     JoinRule &rule = static_cast<JoinRule &>(rule_);
 
     JoinHashKey key;
     key.reserve(rule.get_number_joining_vars());
     for (int i : rule.get_position_of_matching_vars(position)) {
-        key.push_back(fact.argument(i).get_index());
+        key.push_back(fact.argument(i));
     }
 
     // Insert the fact in the hash table of the key
-    rule.insert_fact_in_hash(fact, key, position);
+    rule.insert_fact_in_hash(fact.get_fact_index(), key, position);
 
     // See comment in "project" about 'new_arguments' vector
     Arguments new_arguments_persistent = rule.get_effect_arguments();
@@ -188,20 +292,21 @@ void WeightedGrounder::join(
         int pos = rule.get_head_position_of_arg(arg);
         if (pos!=-1 and !arg.is_object()) {
             new_arguments_persistent.set_term_to_object(pos,
-                                                        fact.argument(position_counter).get_index());
+                                                        fact.argument(position_counter));
         }
         position_counter++;
     }
 
     const int inverse_position = rule.get_inverse_position(position);
-    for (const Fact &f : rule.get_facts_matching_key(key, inverse_position)) {
+    for (int index : rule.get_facts_matching_key(key, inverse_position)) {
+        const FactView f = lp.get_fact_by_index(index);
         Arguments new_arguments = new_arguments_persistent;
         position_counter = 0;
         for (auto &arg : rule.get_condition_arguments(inverse_position)) {
             int pos = rule.get_head_position_of_arg(arg);
             if (pos!=-1 and !arg.is_object()) {
                 new_arguments.set_term_to_object(pos,
-                                                 f.argument(position_counter).get_index());
+                                                 f.argument(position_counter));
             }
             position_counter++;
         }
@@ -223,8 +328,8 @@ void WeightedGrounder::join(
  * (2) every free variable in the body is also in the head
  *
  */
-void WeightedGrounder::product(
-        RuleBase &rule_, const Fact &fact, int position, std::vector<Fact>& newfacts) {
+void WeightedGrounder::product(const LogicProgram &lp,
+        RuleBase &rule_, const FactView &fact, int position, std::vector<Fact>& newfacts) {
     ProductRule &rule = static_cast<ProductRule &>(rule_);
 
     const auto& args = rule.get_condition_arguments(position);
@@ -233,14 +338,14 @@ void WeightedGrounder::product(
     // then it matches the fact being expanded
     int c = 0;
     for (const auto& term:args) {
-        if (term.is_object() and term.get_index()!=fact.argument(c).get_index()) {
+        if (term.is_object() and term.get_index()!=fact.argument(c)) {
             return;
         }
         ++c;
     }
 
     // Check that *all* other positions of the effect have at least one tuple
-    rule.add_reached_fact_to_condition(fact, position, fact.get_cost());
+    rule.add_reached_fact_to_condition(fact.get_fact_index(), position, fact.get_cost());
     int total_cost = 0;
     Achievers nullary_head_achievers;
     for (const ReachedFacts &v : rule.get_reached_facts_all_conditions()) {
@@ -281,7 +386,7 @@ void WeightedGrounder::product(
         int pos = rule.get_head_position_of_arg(arg);
         if (pos!=-1) {
             new_arguments_persistent.set_term_to_object(pos,
-                                                        fact.argument(position_counter).get_index());
+                                                        fact.argument(position_counter));
         }
         position_counter++;
     }
@@ -307,7 +412,9 @@ void WeightedGrounder::product(
             q.emplace_back(next.arguments, next.index + 1, next.cost, next.achievers);
         } else {
             int vector_counter = 0;
-            for (const auto &assignment : rule.get_reached_facts_of_condition(next.index)) {
+            for (int reached_fact : rule.get_reached_facts_of_condition(next.index)) {
+                // The facts of the program do not change while the rule is applied
+                IndexRange assignment = lp.get_fact_arguments(reached_fact);
                 Arguments new_arguments = next.arguments; // start as a copy
                 size_t value_counter = 0;
                 for (const Term &term : rule.get_condition_arguments(next.index)) {
@@ -315,7 +422,7 @@ void WeightedGrounder::product(
                     int pos = rule.get_head_position_of_arg(term);
                     if (pos!=-1) {
                         new_arguments.set_term_to_object(pos,
-                                                         assignment[value_counter].get_index());
+                                                         assignment[value_counter]);
                     }
                     ++value_counter;
                 }
@@ -332,11 +439,11 @@ void WeightedGrounder::product(
     }
 }
 
-void WeightedGrounder::compute_best_achievers(const Fact &fact, const LogicProgram &lp) {
+void WeightedGrounder::compute_best_achievers(int fact_index, const LogicProgram &lp) {
     unordered_set<int> marked_achievers;
     queue<int> achievers_queue;
-    achievers_queue.emplace(fact.get_fact_index());
-    best_achievers.push_back(fact.get_fact_index());
+    achievers_queue.emplace(fact_index);
+    best_achievers.push_back(fact_index);
 
     while (!achievers_queue.empty()) {
         int index = achievers_queue.front();
@@ -345,17 +452,15 @@ void WeightedGrounder::compute_best_achievers(const Fact &fact, const LogicProgr
         if (!is_marked.second) {
             continue;
         }
-        const Fact &f = lp.get_fact_by_index(index);
-        for (int achiever : f.get_achievers()) {
-            const Fact &achiever_fact = lp.get_fact_by_index(achiever);
-            //achiever_fact.print_atom(lp.get_objects(), lp.get_map_index_to_atom());
-            //cout << " " << achiever_fact.get_fact_index() << " " << achiever_fact.get_cost() << endl;
+        for (int achiever : lp.get_fact_achievers(index)) {
+            //lp.get_fact_by_index(achiever).print_atom(lp.get_objects(), lp.get_map_index_to_atom());
+            //cout << " " << achiever << " " << lp.get_fact_cost(achiever) << endl;
             if (facts_in_edb.count(achiever) == 0) {
                 // We ignore fluents and static information that are true in the evaluated state
                 best_achievers.push_back(achiever);
                 achievers_queue.push(achiever);
             } else {
-                if (achiever_fact.get_cost() > 0) {
+                if (lp.get_fact_cost(achiever) > 0) {
                     // If a fact in the EDB has cost > 0, it means it is a fact
                     // achieved by a rule with an empty body.
                     // TODO Problematic with zero-cost domains
@@ -373,6 +478,18 @@ void WeightedGrounder::compute_best_achievers(const Fact &fact, const LogicProgr
     cout << endl;*/
 }
 
+bool WeightedGrounder::has_small_weights(const LogicProgram &lp) {
+    for (const auto &rule : lp.get_rules()) {
+        if (rule->get_weight() > MAX_WEIGHT_LAYERED_GROUNDING)
+            return false;
+    }
+    for (int id = 0, n = lp.get_number_of_facts(); id < n; ++id) {
+        if (lp.get_fact_cost(id) > MAX_WEIGHT_LAYERED_GROUNDING)
+            return false;
+    }
+    return true;
+}
+
 void WeightedGrounder::create_rule_matcher(const LogicProgram &lp) {
     // Loop over rule conditions
     for (const auto &rule : lp.get_rules()) {
@@ -7,6 +7,7 @@
 
 #include "../../algorithms/priority_queues.h"
 #include "../fact.h"
+#include "../logic_program.h"
 
 #include <iostream>
 #include <unordered_set>
@@ -18,18 +19,80 @@ class RuleBase;
 
 const int HAS_CHEAPER_PATH = -2;
 
+// Largest rule weight for which the facts are grounded in cost layers
+const int MAX_WEIGHT_LAYERED_GROUNDING = 16;
+
 enum {H_ADD, H_MAX};
 
+/*
+ * Set of the facts reached by the grounder, stored as their indices in the
+ * logic program. Facts are hashed and compared through the fact tables of the
+ * program, so the set keeps no copy of them. A fact that is not in the program
+ * yet is looked up through the reserved index PROBE.
+ */
+class ReachedFactIndices {
+    static constexpr int PROBE = -1;
+
+    struct Hash {
+        const ReachedFactIndices *facts;
+        std::size_t operator()(int index) const;
+    };
+
+    struct Equal {
+        const ReachedFactIndices *facts;
+        bool operator()(int a, int b) const;
+    };
+
+    const LogicProgram *lp;
+    const Fact *probe;
+    std::unordered_set<int, Hash, Equal> indices;
+
+public:
+    ReachedFactIndices() : lp(nullptr), probe(nullptr), indices(0, Hash{this}, Equal{this}) {}
+
+    ReachedFactIndices(const ReachedFactIndices &) = delete;
+    ReachedFactIndices &operator=(const ReachedFactIndices &) = delete;
+
+    void reset(const LogicProgram &program) {
+        lp = &program;
+        indices.clear();
+    }
+
+    //! The fact must be in the program and not be equal to a reached fact
+    void insert(int index) {
+        indices.insert(index);
+    }
+
+    //! Index of the reached fact with the predicate and arguments of 'f', or -1
+    int find(const Fact &f);
+};
+
 class WeightedGrounder : public Grounder {
-    static int is_cheapest_path_to_achieve_fact(Fact &new_fact,
-                                         std::unordered_set<Fact> &reached_facts,
-                                         LogicProgram &lp);
+    int is_cheapest_path_to_achieve_fact(Fact &new_fact, LogicProgram &lp);
 
     priority_queues::AdaptiveQueue<int> q;
 
+    // Used instead of the queue if all rules have small weights
+    bool use_layered_grounding;
+    std::vector<std::vector<int>> layers;
+    std::vector<bool> expanded;
+
+    std::vector<Fact> newfacts;
+
+    ReachedFactIndices reached_facts;
+
     std::unordered_set<int> facts_in_edb;
     Achievers best_achievers;
 
+    static bool has_small_weights(const LogicProgram &lp);
+
+    int ground_in_layers(LogicProgram &lp, int goal_predicate);
+
+    template<typename PushFunction>
+    void expand(const FactView &current_fact,
+                LogicProgram &lp,
+                const PushFunction &push);
+
 protected:
     int heuristic_type;
 
@@ -37,9 +100,11 @@ protected:
 
     void create_rule_matcher(const LogicProgram &lp);
 
-    void project(const RuleBase &rule, const Fact &fact, std::vector<Fact>& newfacts);
-    void join(RuleBase &rule, const Fact &fact, int position, std::vector<Fact>& newfacts);
-    void product(RuleBase &rule, const Fact &fact, int position, std::vector<Fact>& newfacts);
+    void project(const RuleBase &rule, const FactView &fact, std::vector<Fact>& newfacts);
+    void join(const LogicProgram &lp, RuleBase &rule, const FactView &fact, int position,
+              std::vector<Fact>& newfacts);
+    void product(const LogicProgram &lp, RuleBase &rule, const FactView &fact, int position,
+                 std::vector<Fact>& newfacts);
 
     int aggregation_function(int i, int j) const {
         return (heuristic_type == H_ADD) ? i + j : std::max(i, j);
@@ -49,13 +114,14 @@ public:
     WeightedGrounder(const LogicProgram &lp, int h)  {
         create_rule_matcher(lp);
         heuristic_type = h;
+        use_layered_grounding = has_small_weights(lp);
     }
 
     ~WeightedGrounder() override = default;
 
     int ground(LogicProgram &lp, int goal_predicate) override;
 
-    void compute_best_achievers(const Fact &fact, const LogicProgram &lp);
+    void compute_best_achievers(int fact_index, const LogicProgram &lp);
 
     const Achievers &get_best_achievers() const {
         return best_achievers;
@@ -8,15 +8,29 @@
 
 using namespace std;
 
+static unordered_map<string, size_t> compute_fluent_sizes(const Task &task) {
+    unordered_map<string, size_t> sizes;
+    for (const auto &relation : task.initial_state.get_relations()) {
+        const Predicate &predicate = task.predicates[relation.predicate_symbol];
+        if (!predicate.isStaticPredicate())
+            sizes[predicate.getName()] = relation.tuples.size();
+    }
+    return sizes;
+}
+
 LiftedHeuristic::LiftedHeuristic(const Task &task, std::ifstream &in, int heuristic_type)
-    : logic_program(lifted_heuristic::parse_logic_program(in)),
+    : logic_program(lifted_heuristic::parse_logic_program(in, compute_fluent_sizes(task))),
     grounder(logic_program, heuristic_type)
     {
     useful_nullary_atoms.resize(task.initial_state.get_nullary_atoms().size());
     int pred_idx = 0;
     for (const auto &predicate : task.predicates) {
         useful_atoms[pred_idx] = std::vector<GroundAtom>();
-        indices_map.add_predicate_mapping(pred_idx++, logic_program.get_atom_by_name(predicate.getName()));
+        // Predicates only occurring in negated preconditions or delete effects are
+        // not part of the logic program, since they are irrelevant for the relaxation
+        if (logic_program.has_atom(predicate.getName()))
+            indices_map.add_predicate_mapping(pred_idx, logic_program.get_atom_by_name(predicate.getName()));
+        ++pred_idx;
     }
     for (const auto &object : task.objects) {
         indices_map.add_object_mapping(object.getIndex(), logic_program.get_object_by_name(object.getName()));
@@ -32,7 +46,7 @@ LiftedHeuristic::LiftedHeuristic(const Task &task, std::ifstream &in, int heuris
         cout << "Initializing additive heuristic..." << endl;
     if (heuristic_type == lifted_heuristic::H_MAX)
         cout << "Initializing h-max heuristic..." << endl;
-    cout << "Total number of static atoms in the EDB: " << logic_program.get_facts().size() << endl;
+    cout << "Total number of static atoms in the EDB: " << logic_program.get_number_of_facts() << endl;
     cout << "Total number of rules: " << logic_program.get_rules().size() << endl;
 }
 
@@ -59,6 +73,8 @@ void LiftedHeuristic::transform_state_into_edb(const DBState &s,
     vector<lifted_heuristic::Fact> edb;
 
     for (const auto &r : s.get_relations()) {
+        if (!indices_map.has_predicate(r.predicate_symbol))
+            continue;
         for (const auto &tuple : r.tuples) {
             vector<pair<int, int>> args;
             args.reserve(tuple.size());
@@ -72,7 +88,7 @@ void LiftedHeuristic::transform_state_into_edb(const DBState &s,
 
     const vector<bool>& nullary_atoms = s.get_nullary_atoms();
     for (int index : nullaries) {
-        if (nullary_atoms[index]) {
+        if (nullary_atoms[index] and indices_map.has_predicate(index)) {
             lifted_heuristic::Arguments nullary_arguments;
             edb.emplace_back(nullary_arguments, indices_map.get_predicate(index));
         }
@@ -94,16 +110,16 @@ void LiftedHeuristic::get_useful_facts(const Task &task, const lifted_heuristic:
         useful_nullary_atom = false;
 
     for (int achiever : grounder.get_best_achievers()) {
-        const lifted_heuristic::Fact& fact = lp.get_fact_by_index(achiever);
-        if (indices_map.is_auxiliary_predicate(fact.get_predicate_index()))
+        int predicate_index = lp.get_fact_predicate(achiever);
+        if (indices_map.is_auxiliary_predicate(predicate_index))
             continue;
-        int task_predicate_index = indices_map.get_inverse_predicate(fact.get_predicate_index());
+        int task_predicate_index = indices_map.get_inverse_predicate(predicate_index);
         GroundAtom ga;
         if (task.nullary_predicates.count(task_predicate_index) > 0) {
             useful_nullary_atoms[task_predicate_index] = true;
         }
-        for (const auto  &arg : fact.get_arguments()) {
-            ga.push_back(indices_map.get_inverse_object(arg.get_index()));
+        for (int object : lp.get_fact_arguments(achiever)) {
+            ga.push_back(indices_map.get_inverse_object(object));
         }
         useful_atoms[task_predicate_index].push_back(ga);
     }
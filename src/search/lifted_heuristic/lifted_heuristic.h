@@ -51,6 +51,10 @@ public:
         inverse_predicate_symbol_map[j] = i;
     }
 
+    bool has_predicate(int i) const {
+        return predicate_symbol_map.count(i) > 0;
+    }
+
     int get_predicate(int i) {
         assert (predicate_symbol_map.find(i) != predicate_symbol_map.end());
         return predicate_symbol_map.at(i);
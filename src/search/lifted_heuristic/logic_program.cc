@@ -1,17 +1,39 @@
 #include "logic_program.h"
 
+#include <iostream>
 #include <vector>
 
 using namespace std;
 
 namespace lifted_heuristic {
 
-void LogicProgram::insert_fact(const Fact &f) {
-    facts.push_back(f);
+int FactTable::push_back(const Fact &f) {
+    assert(arity == -1 || size_t(arity) == f.get_arguments().size());
+    arity = f.get_arguments().size();
+    for (const Term &t : f.get_arguments()) {
+        assert(t.is_object());
+        arguments.push_back(t.get_index());
+    }
+    costs.push_back(f.get_cost());
+    achievers.insert(achievers.end(), f.get_achievers().begin(), f.get_achievers().end());
+    achiever_begin.push_back(achievers.size());
+    return costs.size() - 1;
+}
+
+void FactTable::pop_back() {
+    assert(!costs.empty());
+    costs.pop_back();
+    arguments.resize(costs.size() * arity);
+    achiever_begin.pop_back();
+    achievers.resize(achiever_begin.back());
 }
 
-const vector<Fact> &LogicProgram::get_facts() const {
-    return facts;
+void LogicProgram::insert_fact(const Fact &f) {
+    assert(size_t(f.get_fact_index()) == fact_locations.size());
+    int predicate = f.get_predicate_index();
+    if (size_t(predicate) >= fact_tables.size())
+        fact_tables.resize(predicate + 1);
+    fact_locations.push_back({predicate, fact_tables[predicate].push_back(f)});
 }
 
 const vector<unique_ptr<RuleBase>> &LogicProgram::get_rules() const {
@@ -22,12 +44,20 @@ RuleBase &LogicProgram::get_rule_by_index(int index) {
     return *rules[index];
 }
 
-const Fact &LogicProgram::get_fact_by_index(int index) const {
-    return facts[index];
+void FactView::print_atom(const vector<Object> &obj,
+                          const unordered_map<int, string> &map_index_to_atom) const {
+    cout << map_index_to_atom.at(get_predicate_index()) << '(';
+    IndexRange arguments = get_arguments();
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (i > 0)
+            cout << ", ";
+        cout << obj[arguments[i]].get_name();
+    }
+    cout << ')';
 }
 
-size_t LogicProgram::get_number_of_facts() {
-    return facts.size();
+size_t LogicProgram::get_number_of_facts() const {
+    return fact_locations.size();
 }
 
 const std::string &LogicProgram::get_atom_by_index(int index) const {
@@ -41,8 +71,12 @@ int LogicProgram::get_atom_by_name(const std::string &name) const {
 }
 
 void LogicProgram::reset_facts(size_t i) {
-    assert(facts.size() >= i);
-    facts.erase(facts.begin()+i, facts.end());
+    assert(fact_locations.size() >= i);
+    // The facts with the highest indices are the last rows of their tables
+    while (fact_locations.size() > i) {
+        fact_tables[fact_locations.back().predicate].pop_back();
+        fact_locations.pop_back();
+    }
 }
 
 int LogicProgram::get_object_by_name(const std::string &name) const {
@@ -50,7 +84,8 @@ int LogicProgram::get_object_by_name(const std::string &name) const {
 }
 
 void LogicProgram::update_fact_cost(int fact, int cost) {
-    facts[fact].set_cost(cost);
+    const FactLocation &location = fact_locations[fact];
+    fact_tables[location.predicate].set_cost(location.row, cost);
 }
 
 }
\ No newline at end of file
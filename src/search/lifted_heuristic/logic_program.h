@@ -5,6 +5,7 @@
 #include "object.h"
 #include "rules/rule_base.h"
 
+#include <cassert>
 #include <deque>
 #include <memory>
 #include <unordered_map>
@@ -16,8 +17,89 @@ namespace lifted_heuristic {
 
 typedef std::unordered_set<Arguments, HashArguments> FactBucket;
 
+/*
+ * Contiguous range of ints inside one of the columns of a FactTable.
+ */
+class IndexRange {
+    const int *first;
+    const int *last;
+
+public:
+    IndexRange(const int *first, const int *last) : first(first), last(last) {}
+
+    const int *begin() const {
+        return first;
+    }
+
+    const int *end() const {
+        return last;
+    }
+
+    size_t size() const {
+        return last - first;
+    }
+
+    int operator[](size_t i) const {
+        assert(i < size());
+        return first[i];
+    }
+};
+
+/*
+ * The facts of a single predicate, stored column-wise. The arguments of row r
+ * are the objects arguments[r * arity, (r + 1) * arity), and its achievers are
+ * achievers[achiever_begin[r], achiever_begin[r + 1]).
+ *
+ * Rows are only added at the end and removed from the end, in the same order
+ * as the fact indices of the LogicProgram.
+ */
+class FactTable {
+    int arity;
+    std::vector<int> arguments;
+    std::vector<int> costs;
+    std::vector<int> achiever_begin;
+    std::vector<int> achievers;
+
+public:
+    FactTable() : arity(-1), achiever_begin({0}) {}
+
+    int push_back(const Fact &f);
+
+    void pop_back();
+
+    size_t size() const {
+        return costs.size();
+    }
+
+    IndexRange get_arguments(int row) const {
+        return IndexRange(arguments.data() + row * arity, arguments.data() + (row + 1) * arity);
+    }
+
+    int get_cost(int row) const {
+        return costs[row];
+    }
+
+    void set_cost(int row, int cost) {
+        costs[row] = cost;
+    }
+
+    IndexRange get_achievers(int row) const {
+        return IndexRange(achievers.data() + achiever_begin[row],
+                          achievers.data() + achiever_begin[row + 1]);
+    }
+};
+
+class FactView;
+
 class LogicProgram {
-    std::vector<Fact> facts;
+    struct FactLocation {
+        int predicate;
+        int row;
+    };
+
+    // Fact tables indexed by predicate, and the location of every fact index
+    std::vector<FactTable> fact_tables;
+    std::vector<FactLocation> fact_locations;
     std::vector<Object> objects;
     std::vector<std::unique_ptr<RuleBase>> rules;
     std::unordered_map<int, std::string> map_index_to_atom;
@@ -33,18 +115,19 @@ public:
                  std::unordered_map<int, std::string> &&m,
                  std::unordered_map<std::string, int> &&a_to_i,
                  std::unordered_map<std::string, int> &&o_to_i)
-        : facts(std::move(f)),
-          objects(std::move(o)),
+        : objects(std::move(o)),
           rules(std::move(r)),
           map_index_to_atom(std::move(m)),
           map_atom_to_index(std::move(a_to_i)),
-          map_object_to_index(std::move(o_to_i)){}
+          map_object_to_index(std::move(o_to_i)) {
+        for (const Fact &fact : f)
+            insert_fact(fact);
+    }
 
 
+    //! The fact index of 'f' must be the number of facts in the program
     void insert_fact(const Fact &f);
 
-    const std::vector<Fact> &get_facts() const;
-
     const std::vector<std::unique_ptr<RuleBase>> &get_rules() const;
 
     const std::vector<Object> &get_objects() const {
@@ -57,15 +140,38 @@ public:
 
     RuleBase &get_rule_by_index(int index);
 
-    const Fact &get_fact_by_index(int index) const;
+    FactView get_fact_by_index(int index) const;
+
+    int get_fact_predicate(int index) const {
+        return fact_locations[index].predicate;
+    }
+
+    IndexRange get_fact_arguments(int index) const {
+        const FactLocation &location = fact_locations[index];
+        return fact_tables[location.predicate].get_arguments(location.row);
+    }
+
+    int get_fact_cost(int index) const {
+        const FactLocation &location = fact_locations[index];
+        return fact_tables[location.predicate].get_cost(location.row);
+    }
+
+    IndexRange get_fact_achievers(int index) const {
+        const FactLocation &location = fact_locations[index];
+        return fact_tables[location.predicate].get_achievers(location.row);
+    }
 
     const std::string &get_atom_by_index(int index) const;
 
     int get_atom_by_name(const std::string &name) const;
 
+    bool has_atom(const std::string &name) const {
+        return map_atom_to_index.count(name) > 0;
+    }
+
     int get_object_by_name(const std::string &name) const;
 
-    size_t get_number_of_facts();
+    size_t get_number_of_facts() const;
 
     void clean_rule(int r) {
         rules[r].reset();
@@ -76,6 +182,51 @@ public:
     void reset_facts(size_t i);
 };
 
+/*
+ * Read-only view of a fact of a LogicProgram. It only keeps the program and the
+ * fact index, so, unlike the IndexRanges it returns, it stays valid when facts
+ * are added to the program.
+ */
+class FactView {
+    const LogicProgram *lp;
+    int index;
+
+public:
+    FactView(const LogicProgram &lp, int index) : lp(&lp), index(index) {}
+
+    int get_fact_index() const {
+        return index;
+    }
+
+    int get_predicate_index() const {
+        return lp->get_fact_predicate(index);
+    }
+
+    int get_cost() const {
+        return lp->get_fact_cost(index);
+    }
+
+    //! Object of the i-th argument
+    int argument(size_t i) const {
+        return lp->get_fact_arguments(index)[i];
+    }
+
+    IndexRange get_arguments() const {
+        return lp->get_fact_arguments(index);
+    }
+
+    IndexRange get_achievers() const {
+        return lp->get_fact_achievers(index);
+    }
+
+    void print_atom(const std::vector<Object> &obj,
+                    const std::unordered_map<int, std::string> &map_index_to_atom) const;
+};
+
+inline FactView LogicProgram::get_fact_by_index(int index) const {
+    return FactView(*this, index);
+}
+
 }
 
 #endif
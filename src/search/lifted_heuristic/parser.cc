@@ -1,5 +1,7 @@
 #include "parser.h"
 
+#include "rule_splitting.h"
+
 #include "rules/join.h"
 #include "rules/product.h"
 #include "rules/project.h"
@@ -19,7 +21,8 @@ int number_of_facts = 0;
 int number_of_rules = 0;
 int number_of_objects = 0;
 
-LogicProgram parse_logic_program(ifstream &in) {
+LogicProgram parse_logic_program(ifstream &in,
+                                 const unordered_map<string, size_t> &fluent_sizes) {
     cout << "Parsing file..." << endl;
 
     unordered_map<string, int> map_object_to_index;
@@ -28,7 +31,7 @@ LogicProgram parse_logic_program(ifstream &in) {
 
     vector<Object> lp_objects;
     vector<Fact> lp_facts;
-    vector<unique_ptr<RuleBase>> rules;
+    vector<RuleDefinition> rule_definitions;
 
     string line;
 
@@ -99,13 +102,13 @@ LogicProgram parse_logic_program(ifstream &in) {
 
             if (boost::iequals(rule_type, "project")) {
                 // Project rule
-                rules.emplace_back(make_unique<ProjectRule>(weight, head_atom, condition_atoms));
+                rule_definitions.emplace_back(PROJECT, weight, head_atom, condition_atoms);
             } else if (boost::iequals(rule_type, "join")) {
                 // Join rule
-                rules.emplace_back(make_unique<JoinRule>(weight, head_atom, condition_atoms));
+                rule_definitions.emplace_back(JOIN, weight, head_atom, condition_atoms);
             } else if (boost::iequals(rule_type, "product")) {
                 // Product rule
-                rules.emplace_back(make_unique<ProductRule>(weight, head_atom, condition_atoms));
+                rule_definitions.emplace_back(PRODUCT, weight, head_atom, condition_atoms);
             }
 
             number_of_rules++;
@@ -147,6 +150,45 @@ LogicProgram parse_logic_program(ifstream &in) {
     for (Fact &f : lp_facts)
         f.set_fact_index();
 
+    // Sizes of the EDB relations: static facts from the file and fluents from the
+    // initial state of the task
+    vector<double> predicate_sizes(number_of_atoms, -1);
+    for (const auto &entry : fluent_sizes) {
+        auto it = map_atom_to_index.find(entry.first);
+        if (it != map_atom_to_index.end())
+            predicate_sizes[it->second] = entry.second;
+    }
+    for (const Fact &f : lp_facts) {
+        double &size = predicate_sizes[f.get_predicate_index()];
+        size = max(size, 0.0) + 1;
+    }
+    vector<bool> is_auxiliary(number_of_atoms, false);
+    for (const auto &entry : map_index_to_atom) {
+        is_auxiliary[entry.first] = boost::starts_with(entry.second, "p$");
+    }
+    int number_of_auxiliary_atoms = 0;
+    auto new_auxiliary_predicate = [&]() {
+        string name;
+        do {
+            name = "p$split" + to_string(number_of_auxiliary_atoms++);
+        } while (map_atom_to_index.count(name));
+        map_atom_to_index.emplace(name, number_of_atoms);
+        map_index_to_atom.emplace(number_of_atoms, name);
+        return number_of_atoms++;
+    };
+    rule_definitions = resplit_rules(move(rule_definitions), predicate_sizes, is_auxiliary,
+                                     lp_objects.size(), new_auxiliary_predicate);
+
+    vector<unique_ptr<RuleBase>> rules;
+    for (RuleDefinition &r : rule_definitions) {
+        if (r.type == PROJECT)
+            rules.emplace_back(make_unique<ProjectRule>(r.weight, move(r.effect), move(r.conditions)));
+        else if (r.type == JOIN)
+            rules.emplace_back(make_unique<JoinRule>(r.weight, move(r.effect), move(r.conditions)));
+        else
+            rules.emplace_back(make_unique<ProductRule>(r.weight, move(r.effect), move(r.conditions)));
+    }
+
     return LogicProgram(move(lp_facts),
         move(lp_objects),
         move(rules),
@@ -9,7 +9,12 @@
 
 namespace lifted_heuristic {
 
-LogicProgram parse_logic_program(std::ifstream &in);
+/*
+ * Parse the Datalog model. 'fluent_sizes' maps the fluent predicates to the size of
+ * their relation in the initial state and is used to re-split the rules.
+ */
+LogicProgram parse_logic_program(std::ifstream &in,
+                                 const std::unordered_map<std::string, size_t> &fluent_sizes);
 
 bool is_warning_message(const std::string &line);
 
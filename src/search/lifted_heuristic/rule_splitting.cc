@@ -0,0 +1,294 @@
+#include "rule_splitting.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+namespace lifted_heuristic {
+
+static bool has_only_distinct_variables(const Atom &atom)
+{
+    unordered_set<int> seen;
+    for (const Term &t : atom.get_arguments()) {
+        if (t.is_object() or !seen.insert(t.get_index()).second)
+            return false;
+    }
+    return true;
+}
+
+static bool is_simple_join(const RuleDefinition &rule)
+{
+    if (rule.type != JOIN or rule.conditions.size() != 2)
+        return false;
+    if (!has_only_distinct_variables(rule.effect))
+        return false;
+    return all_of(rule.conditions.begin(), rule.conditions.end(), has_only_distinct_variables);
+}
+
+static vector<int> variables_of(const Atom &atom)
+{
+    vector<int> variables;
+    for (const Term &t : atom.get_arguments())
+        variables.push_back(t.get_index());
+    return variables;
+}
+
+static bool contains(const vector<int> &v, int x)
+{
+    return find(v.begin(), v.end(), x) != v.end();
+}
+
+/*
+ * Estimated size of a relation over the given variables.
+ */
+struct Estimate {
+    double size;
+    vector<int> variables;
+};
+
+class RuleSplitter {
+    const vector<RuleDefinition> &rules;
+    const vector<double> &predicate_sizes;
+    double number_objects;
+
+public:
+    // Auxiliary predicates that can be unfolded, mapped to the rule defining them
+    unordered_map<int, int> unfoldable;
+
+    RuleSplitter(const vector<RuleDefinition> &rules,
+                 const vector<double> &predicate_sizes,
+                 size_t number_objects)
+        : rules(rules), predicate_sizes(predicate_sizes), number_objects(number_objects) {}
+
+    Estimate base_relation(const Atom &atom) const {
+        size_t p = atom.get_predicate_index();
+        double size = pow(number_objects, atom.get_arguments().size());
+        if (p < predicate_sizes.size() and predicate_sizes[p] >= 0)
+            size = predicate_sizes[p];
+        return {size, variables_of(atom)};
+    }
+
+    Estimate join(const Estimate &a, const Estimate &b) const {
+        Estimate result{a.size * b.size, a.variables};
+        for (int v : b.variables) {
+            if (contains(a.variables, v)) {
+                double distinct_values = max(min(a.size, number_objects), min(b.size, number_objects));
+                result.size /= max(distinct_values, 1.0);
+            }
+            else {
+                result.variables.push_back(v);
+            }
+        }
+        return result;
+    }
+
+    Estimate project(const Estimate &e, const vector<int> &keep) const {
+        Estimate result{e.size, {}};
+        for (int v : e.variables) {
+            if (contains(keep, v))
+                result.variables.push_back(v);
+        }
+        result.size = min(result.size, pow(number_objects, result.variables.size()));
+        return result;
+    }
+
+    /*
+     * Estimate the head of a rule as split by the translator, adding the sizes of the
+     * unfoldable auxiliary relations it depends on to 'cost'.
+     */
+    Estimate estimate_original_split(const RuleDefinition &rule, double &cost) const {
+        Estimate result{1, {}};
+        for (const Atom &condition : rule.conditions) {
+            Estimate e;
+            auto it = unfoldable.find(condition.get_predicate_index());
+            if (it != unfoldable.end()) {
+                e.size = estimate_original_split(rules[it->second], cost).size;
+                e.variables = variables_of(condition);
+                cost += e.size;
+            }
+            else {
+                e = base_relation(condition);
+            }
+            result = join(result, e);
+        }
+        return project(result, variables_of(rule.effect));
+    }
+
+    /*
+     * Replace the atom by the body of the rule defining it (recursively), renaming the
+     * variables that do not occur in the head of that rule.
+     */
+    void unfold(const Atom &atom, vector<Atom> &body, int &next_variable,
+                vector<int> &unfolded_rules) const {
+        auto it = unfoldable.find(atom.get_predicate_index());
+        if (it == unfoldable.end()) {
+            body.push_back(atom);
+            return;
+        }
+        const RuleDefinition &definition = rules[it->second];
+        unfolded_rules.push_back(it->second);
+
+        unordered_map<int, Term> substitution;
+        const Arguments &head_arguments = definition.effect.get_arguments();
+        for (size_t i = 0; i < head_arguments.size(); ++i)
+            substitution.emplace(head_arguments[i].get_index(), atom.argument(i));
+
+        for (const Atom &condition : definition.conditions) {
+            vector<Term> arguments;
+            for (const Term &t : condition.get_arguments()) {
+                auto s = substitution.find(t.get_index());
+                if (s == substitution.end())
+                    s = substitution.emplace(t.get_index(), Term(next_variable++, VARIABLE)).first;
+                arguments.push_back(s->second);
+            }
+            unfold(Atom(Arguments(move(arguments)), condition.get_predicate_index()),
+                   body, next_variable, unfolded_rules);
+        }
+    }
+
+    /*
+     * Split the body greedily: join first the pair of atoms with the smallest
+     * estimated result, preferring pairs sharing some variable. The sizes of the new
+     * auxiliary relations are added to 'cost'.
+     */
+    vector<RuleDefinition> split(const RuleDefinition &root, vector<Atom> body, double &cost,
+                                 const function<int()> &new_auxiliary_predicate) const {
+        vector<Estimate> estimates;
+        for (const Atom &atom : body)
+            estimates.push_back(base_relation(atom));
+        vector<int> head_variables = variables_of(root.effect);
+
+        vector<RuleDefinition> result;
+        while (body.size() > 2) {
+            size_t best_i = 0, best_j = 1;
+            Estimate best{-1, {}};
+            bool best_shares = false;
+            for (size_t i = 0; i < body.size(); ++i) {
+                for (size_t j = i + 1; j < body.size(); ++j) {
+                    vector<int> needed = head_variables;
+                    for (size_t k = 0; k < body.size(); ++k) {
+                        if (k == i or k == j)
+                            continue;
+                        const auto &vars = estimates[k].variables;
+                        needed.insert(needed.end(), vars.begin(), vars.end());
+                    }
+                    bool shares = any_of(estimates[j].variables.begin(),
+                                         estimates[j].variables.end(),
+                                         [&](int v) { return contains(estimates[i].variables, v); });
+                    Estimate e = project(join(estimates[i], estimates[j]), needed);
+                    if (best.size < 0 or (shares and !best_shares) or
+                        (shares == best_shares and e.size < best.size)) {
+                        best = move(e);
+                        best_shares = shares;
+                        best_i = i;
+                        best_j = j;
+                    }
+                }
+            }
+            cost += best.size;
+
+            vector<Term> arguments;
+            for (int v : best.variables)
+                arguments.emplace_back(v, VARIABLE);
+            Atom auxiliary(Arguments(move(arguments)), new_auxiliary_predicate());
+            result.emplace_back(JOIN, 0, auxiliary, vector<Atom>{body[best_i], body[best_j]});
+
+            body.erase(body.begin() + best_j);
+            body.erase(body.begin() + best_i);
+            estimates.erase(estimates.begin() + best_j);
+            estimates.erase(estimates.begin() + best_i);
+            body.push_back(auxiliary);
+            estimates.push_back(move(best));
+        }
+        result.emplace_back(JOIN, root.weight, root.effect, move(body));
+        return result;
+    }
+};
+
+vector<RuleDefinition> resplit_rules(vector<RuleDefinition> &&rules,
+                                     const vector<double> &predicate_sizes,
+                                     const vector<bool> &is_auxiliary,
+                                     size_t number_objects,
+                                     const function<int()> &new_auxiliary_predicate)
+{
+    unordered_map<int, int> number_definitions, number_uses;
+    for (const RuleDefinition &rule : rules) {
+        ++number_definitions[rule.effect.get_predicate_index()];
+        for (const Atom &condition : rule.conditions)
+            ++number_uses[condition.get_predicate_index()];
+    }
+
+    RuleSplitter splitter(rules, predicate_sizes, number_objects);
+    unordered_map<int, int> definition_of;
+    for (size_t r = 0; r < rules.size(); ++r) {
+        const RuleDefinition &rule = rules[r];
+        int p = rule.effect.get_predicate_index();
+        if (is_simple_join(rule) and rule.weight == 0 and is_auxiliary[p] and
+            number_definitions[p] == 1 and number_uses[p] == 1)
+            definition_of[p] = r;
+    }
+    for (size_t r = 0; r < rules.size(); ++r) {
+        if (!is_simple_join(rules[r]))
+            continue;
+        for (const Atom &condition : rules[r].conditions) {
+            auto it = definition_of.find(condition.get_predicate_index());
+            if (it != definition_of.end() and it->second != int(r))
+                splitter.unfoldable.insert(*it);
+        }
+    }
+
+    vector<bool> removed(rules.size(), false);
+    unordered_map<int, vector<RuleDefinition>> replacements;
+    size_t resplit = 0;
+    for (size_t r = 0; r < rules.size(); ++r) {
+        const RuleDefinition &root = rules[r];
+        if (!is_simple_join(root) or splitter.unfoldable.count(root.effect.get_predicate_index()))
+            continue;
+
+        int next_variable = 0;
+        for (const Atom &atom : root.conditions) {
+            for (int v : variables_of(atom))
+                next_variable = max(next_variable, v + 1);
+        }
+        vector<Atom> body;
+        vector<int> unfolded_rules;
+        for (const Atom &atom : root.conditions)
+            splitter.unfold(atom, body, next_variable, unfolded_rules);
+        if (unfolded_rules.empty())
+            continue;
+
+        double original_cost = 0;
+        splitter.estimate_original_split(root, original_cost);
+
+        double new_cost = 0;
+        vector<RuleDefinition> new_rules =
+            splitter.split(root, body, new_cost, new_auxiliary_predicate);
+        if (new_cost >= original_cost)
+            continue;
+
+        for (int u : unfolded_rules)
+            removed[u] = true;
+        replacements.emplace(r, move(new_rules));
+        ++resplit;
+    }
+
+    vector<RuleDefinition> result;
+    for (size_t r = 0; r < rules.size(); ++r) {
+        auto it = replacements.find(r);
+        if (it != replacements.end()) {
+            for (RuleDefinition &rule : it->second)
+                result.push_back(move(rule));
+        }
+        else if (!removed[r]) {
+            result.push_back(move(rules[r]));
+        }
+    }
+    cout << "Re-split " << resplit << " Datalog rule(s) using relation sizes" << endl;
+    return result;
+}
+
+}
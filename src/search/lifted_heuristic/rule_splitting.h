@@ -0,0 +1,55 @@
+#ifndef GROUNDER_RULE_SPLITTING_H
+#define GROUNDER_RULE_SPLITTING_H
+
+#include "atom.h"
+#include "rules/rule_base.h"
+
+#include <functional>
+#include <vector>
+
+namespace lifted_heuristic {
+
+/*
+ * Rule as read from the Datalog model, before creating the RuleBase object.
+ */
+struct RuleDefinition {
+    RuleType type;
+    int weight;
+    Atom effect;
+    std::vector<Atom> conditions;
+
+    RuleDefinition(RuleType type, int weight, Atom effect, std::vector<Atom> conditions)
+        : type(type), weight(weight), effect(std::move(effect)),
+          conditions(std::move(conditions)) {}
+};
+
+/*
+ * Re-split chains of join rules using the sizes of the relations.
+ *
+ * The translator splits every rule of the Datalog model into binary join rules
+ * without knowing the size of the relations, so some auxiliary predicates might have
+ * very large extensions. Here, we undo the split of each join rule: auxiliary
+ * predicates (with weight 0) that are defined by a single join rule and used only
+ * once, in another join rule, are unfolded into their use. Then we split the body
+ * again, greedily joining the pair of atoms with the smallest estimated result. The
+ * new split is kept only if the estimated size of its intermediate relations is
+ * smaller than for the original one.
+ *
+ * The size of a relation is taken from 'predicate_sizes' (static facts and fluent
+ * atoms of the initial state), or estimated as if it held all tuples of objects if
+ * it is negative. The size of a join is estimated assuming that the values of the
+ * shared variables are uniformly distributed.
+ *
+ * Rules with constants or with repeated variables in an atom are not changed. The
+ * heuristic values are not affected, as the grounder computes the cheapest
+ * derivation of each fact regardless of how the rules are split.
+ */
+std::vector<RuleDefinition> resplit_rules(std::vector<RuleDefinition> &&rules,
+                                          const std::vector<double> &predicate_sizes,
+                                          const std::vector<bool> &is_auxiliary,
+                                          size_t number_objects,
+                                          const std::function<int()> &new_auxiliary_predicate);
+
+}
+
+#endif //GROUNDER_RULE_SPLITTING_H
@@ -8,7 +8,6 @@
 #include <cassert>
 #include <utility>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include <boost/functional/hash.hpp>
@@ -17,21 +16,22 @@ namespace lifted_heuristic {
 
 typedef std::vector<int> JoinHashKey;
 
+// Indices of the facts of the logic program with the same key
 class JoinHashEntry {
-    std::unordered_set<Fact> entry;
+    std::vector<int> entry;
 
 public:
     JoinHashEntry() = default;
 
-    void insert(const Fact &f) {
-        entry.insert(f);
+    void insert(int fact_index) {
+        entry.push_back(fact_index);
     }
 
-    std::unordered_set<Fact>::const_iterator begin() const {
+    std::vector<int>::const_iterator begin() const {
         return entry.begin();
     }
 
-    std::unordered_set<Fact>::const_iterator end() const {
+    std::vector<int>::const_iterator end() const {
         return entry.end();
     }
 
@@ -50,14 +50,14 @@ class JoinHashTable {
 public:
     JoinHashTable() = default;
 
-    void insert(const Fact &f, const JoinHashKey &key, int position) {
+    void insert(int fact_index, const JoinHashKey &key, int position) {
         assert (valid_position(position));
         if (position==0) {
 //            hash_table_1.emplace(key, JoinHashEntry()); // redundant
-            hash_table_1[key].insert(f);
+            hash_table_1[key].insert(fact_index);
         } else {
 //            hash_table_2.emplace(key, JoinHashEntry()); // redundant
-            hash_table_2[key].insert(f);
+            hash_table_2[key].insert(fact_index);
         }
     }
 
@@ -138,10 +138,10 @@ public:
         return JOIN;
     }
 
-    void insert_fact_in_hash(const Fact &fact,
+    void insert_fact_in_hash(int fact_index,
                              const JoinHashKey &key,
                              int position) {
-        hash_table_indices.insert(fact, key, position);
+        hash_table_indices.insert(fact_index, key, position);
     }
 
     const JoinHashEntry &get_facts_matching_key(const JoinHashKey &key,
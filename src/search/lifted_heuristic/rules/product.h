@@ -22,31 +22,29 @@ struct ProductDequeEntry {
 };
 
 class ReachedFacts {
-    // We do not use a vector of Facts because the Fact class is more complex than
-    // what we need here for this use case.
-    std::vector<Arguments> facts;
+    // We only keep the indices of the facts in the logic program, their
+    // arguments are read from its fact tables.
     std::vector<int> fact_indices;
     std::vector<int> costs;
 
 public:
     ReachedFacts() = default;
 
-    void push_back(const Fact &fact, int i) {
-        facts.push_back(fact.get_arguments());
-        fact_indices.push_back(fact.get_fact_index());
+    void push_back(int fact_index, int i) {
+        fact_indices.push_back(fact_index);
         costs.push_back(i);
     }
 
     bool empty() const {
-        return facts.empty();
+        return fact_indices.empty();
     }
 
-    std::vector<Arguments>::const_iterator begin() const {
-        return facts.begin();
+    std::vector<int>::const_iterator begin() const {
+        return fact_indices.begin();
     }
 
-    std::vector<Arguments>::const_iterator end() const {
-        return facts.end();
+    std::vector<int>::const_iterator end() const {
+        return fact_indices.end();
     }
 
     int get_cost(int i) const {
@@ -80,8 +78,8 @@ public:
         reached_facts_per_condition.resize(conditions.size());
     }
 
-    void add_reached_fact_to_condition(const Fact &fact, int position, int cost) {
-        reached_facts_per_condition[position].push_back(fact, cost);
+    void add_reached_fact_to_condition(int fact_index, int position, int cost) {
+        reached_facts_per_condition[position].push_back(fact_index, cost);
     }
 
     ReachedFacts &get_reached_facts_of_condition(int i) {
@@ -1,5 +1,7 @@
+#include "invariants.h"
 #include "options.h"
 #include "parser.h"
+#include "relevance_analysis.h"
 #include "task.h"
 
 #ifndef CMAKE_NO_SAT
@@ -11,8 +13,10 @@
 #include "heuristics/heuristic_factory.h"
 #include "search_engines/search.h"
 #include "search_engines/search_factory.h"
+#include "search_engines/utils.h"
 #include "successor_generators/successor_generator.h"
 #include "successor_generators/successor_generator_factory.h"
+#include "utils/budget.h"
 
 #include <iostream>
 #include <memory>
@@ -24,6 +28,8 @@ int main(int argc, char *argv[]) {
     cout << "Initializing planner" << endl;
 
     Options opt(argc, argv);
+    // The limits also cover parsing and preprocessing
+    utils::Budget budget(opt.get_time_limit(), opt.get_cpu_time_limit(), opt.get_memory_limit());
 
     ifstream task_file(opt.get_filename());
     if (!task_file) {
@@ -49,12 +55,23 @@ int main(int argc, char *argv[]) {
     cout << "IMPORTANT: Assuming that negative effects are always listed first. "
             "(This is guaranteed by the default translator.)" << endl;
 
+    prune_irrelevant_schemas(task);
+
+    if (opt.get_invariants()) {
+        task.invariants = synthesize_invariants(task);
+    }
+
+    if (opt.get_postprocess_plan()) {
+        enable_plan_postprocessing(task);
+    }
+
 
 	if (opt.get_search_engine() == "sat"){
 #ifndef CMAKE_NO_SAT
         std::unique_ptr<LiftedSAT> liftedSAT(new LiftedSAT(task));
+        liftedSAT->setLogEncodingThreshold(opt.get_sat_log_encoding());
     	try {
-    	    auto exitcode = liftedSAT->solve(task,opt.get_planLength(), opt.get_optimal(), opt.get_incremental());
+    	    auto exitcode = liftedSAT->solve(task,opt.get_planLength(), opt.get_optimal(), opt.get_incremental(), opt.get_step_slots(), budget);
     	    utils::report_exit_code_reentrant(exitcode);
     	    return static_cast<int>(exitcode);
     	}
@@ -67,11 +84,9 @@ int main(int argc, char *argv[]) {
 #endif
 	} else {
     	// Let's create a couple unique_ptr's that deal with mem allocation themselves
-    	std::unique_ptr<SearchBase> search(SearchFactory::create(opt.get_search_engine(), opt.get_state_representation()));
+    	std::unique_ptr<SearchBase> search(SearchFactory::create(opt, task));
     	std::unique_ptr<Heuristic> heuristic(HeuristicFactory::create(opt, task));
-    	std::unique_ptr<SuccessorGenerator> sgen(SuccessorGeneratorFactory::create(opt.get_successor_generator(),
-    	                                                                           opt.get_seed(),
-    	                                                                           task));
+    	std::unique_ptr<SuccessorGenerator> sgen(SuccessorGeneratorFactory::create(opt, task, budget));
 
     	// Start search
     	if (task.is_trivially_unsolvable()) {
@@ -80,8 +95,9 @@ int main(int argc, char *argv[]) {
     	}
 
     	try {
-    	    auto exitcode = search->search(task, *sgen, *heuristic);
+    	    auto exitcode = search->search(task, *sgen, *heuristic, budget);
     	    search->print_statistics();
+    	    sgen->print_statistics();
     	    utils::report_exit_code_reentrant(exitcode);
     	    return static_cast<int>(exitcode);
     	}
@@ -0,0 +1,68 @@
+#ifndef SEARCH_OPEN_LISTS_ALTERNATION_OPEN_LIST_H_
+#define SEARCH_OPEN_LISTS_ALTERNATION_OPEN_LIST_H_
+
+#include "../search_engines/nodes.h"
+
+#include "greedy_open_list.h"
+
+#include <cassert>
+#include <vector>
+
+/*
+ * Alternation of several greedy open lists (Röger and Helmert, ICAPS 2010). Every removal
+ * takes the minimum of the non-empty sublist with the lowest priority value, and then
+ * increases its priority value by one, so sublists take turns. Boosting a sublist lowers
+ * its priority value, so it is chosen for the next removals.
+ */
+class AlternationOpenList {
+    std::vector<GreedyOpenList> sublists;
+    std::vector<int> priorities;
+    int last_removed_sublist;
+
+public:
+    explicit AlternationOpenList(int num_sublists)
+        : sublists(num_sublists), priorities(num_sublists, 0), last_removed_sublist(-1) {}
+
+    void do_insertion(int sublist, const StateID &entry, const std::pair<int, int> &key) {
+        sublists[sublist].do_insertion(entry, key);
+    }
+
+    StateID remove_min() {
+        int best = -1;
+        for (size_t i = 0; i < sublists.size(); ++i) {
+            if (!sublists[i].empty() and (best == -1 or priorities[i] < priorities[best]))
+                best = i;
+        }
+        assert(best != -1);
+        ++priorities[best];
+        last_removed_sublist = best;
+        return sublists[best].remove_min();
+    }
+
+    //! Index of the sublist of the last removed entry
+    int get_last_removed_sublist() const {
+        return last_removed_sublist;
+    }
+
+    void boost_priority(int sublist, int amount) {
+        priorities[sublist] -= amount;
+    }
+
+    //! Number of entries of all sublists
+    std::size_t size() const {
+        std::size_t result = 0;
+        for (const auto &sublist : sublists)
+            result += sublist.size();
+        return result;
+    }
+
+    bool empty() {
+        for (auto &sublist : sublists) {
+            if (!sublist.empty())
+                return false;
+        }
+        return true;
+    }
+};
+
+#endif //SEARCH_OPEN_LISTS_ALTERNATION_OPEN_LIST_H_
@@ -17,18 +17,18 @@ class GreedyOpenList {
     typedef std::deque<StateID> Bucket;
 
     std::map<std::pair<int, int>, Bucket, CompareGBFSEntries> buckets;
-    int size;
+    int num_entries;
 
 public:
-    GreedyOpenList() : size(0) {}
+    GreedyOpenList() : num_entries(0) {}
 
     void do_insertion(const StateID &entry, const std::pair<int, int>& key) {
         buckets[key].push_back(entry);
-        ++size;
+        ++num_entries;
     }
 
     StateID remove_min() {
-        assert(size > 0);
+        assert(num_entries > 0);
         auto it = buckets.begin();
         assert(it != buckets.end());
         Bucket &bucket = it->second;
@@ -37,12 +37,25 @@ public:
         bucket.pop_front();
         if (bucket.empty())
             buckets.erase(it);
-        --size;
+        --num_entries;
         return result;
     }
 
     bool empty() {
-        return size == 0;
+        return num_entries == 0;
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+
+    //! Call f(entry, key) for all entries, in the order in which they would be removed
+    template <typename F>
+    void for_each(F f) const {
+        for (const auto &bucket : buckets) {
+            for (const StateID &entry : bucket.second)
+                f(entry, bucket.first);
+        }
     }
 
 };
@@ -18,6 +18,26 @@ class Options {
 	unsigned int planLength;
 	bool optimal;
 	bool incremental;
+    unsigned int step_slots;
+    int sat_log_encoding;
+    bool stubborn_sets;
+    bool orbit_search;
+    int grounding_threshold;
+    int beam_width;
+    std::string alternation_heuristics;
+    bool lazy_evaluation;
+    bool cache_instantiations;
+    bool invariants;
+    bool postprocess_plan;
+    std::string checkpoint_file;
+    double checkpoint_interval;
+    bool resume;
+    std::string telemetry_file;
+    double telemetry_interval;
+    long long telemetry_expansions;
+    double time_limit;
+    double cpu_time_limit;
+    int memory_limit;
 
 public:
     Options(int argc, char** argv) {
@@ -33,7 +53,27 @@ public:
             ("datalog-file", po::value<std::string>()->default_value("FilePathUndefined"), "Datalog model file.")
             ("planLength,l", po::value<unsigned>()->default_value(100), "Plan length for the SAT encoding")
             ("optimal,o", "Run the SAT planner in optimal mode")
-            ("incremental,i", "Run the SAT planner in incremenal mode. ATTENTION: this is not supported by all SAT solvers")
+            ("incremental,i", "Run the SAT planner in incremental mode (one solver instance for all plan lengths).")
+            ("step-slots", po::value<unsigned>()->default_value(1), "Number of action slots per step of the SAT encoding. With more than one slot, the plan length counts steps.")
+            ("sat-log-encoding", po::value<int>()->default_value(0), "Log-encode the arguments of the SAT encoding whose type has more objects than this (0 for one-hot arguments only).")
+            ("stubborn-sets", "Prune successors with strong stubborn sets computed over action schemas (bfs and gbfs only).")
+            ("orbit-search", "Detect duplicate states up to object symmetries (sparse states only).")
+            ("cache-instantiations", "Reuse the applicable instantiations of a schema in states where the relations it reads are unchanged.")
+            ("invariants", "Synthesize lifted mutex groups to prune the successor generation, detect dead ends and strengthen the SAT encoding.")
+            ("postprocess-plan", "Validate the plan and remove redundant actions from it before writing it.")
+            ("grounding-threshold", po::value<int>()->default_value(10000), "Maximum number of relaxed-reachable ground actions of a schema to ground it (hybrid generator only).")
+            ("beam-width", po::value<int>()->default_value(100), "Number of states kept per layer (beam search only).")
+            ("alternation-heuristics", po::value<std::string>()->default_value("goalcount"), "Comma-separated heuristics alternating with the evaluator (alt and alt-po only).")
+            ("lazy-evaluation", "Evaluate the evaluator only for states removed from its own open lists (alt and alt-po only).")
+            ("checkpoint-file", po::value<std::string>()->default_value(""), "Periodically save the search to this file (bfs and gbfs only).")
+            ("checkpoint-interval", po::value<double>()->default_value(1800), "Seconds between two checkpoints.")
+            ("resume", "Resume the search from the last checkpoint of the checkpoint file, if there is one.")
+            ("telemetry-file", po::value<std::string>()->default_value(""), "Write progress records of the search as JSON lines to this file or pipe.")
+            ("telemetry-interval", po::value<double>()->default_value(10), "Seconds between two progress records (0 to disable).")
+            ("telemetry-expansions", po::value<long long>()->default_value(0), "Expansions between two progress records (0 to disable).")
+            ("time-limit", po::value<double>()->default_value(0), "Wall-clock time limit in seconds (0 for no limit).")
+            ("cpu-time-limit", po::value<double>()->default_value(0), "CPU time limit in seconds (0 for no limit).")
+            ("memory-limit", po::value<int>()->default_value(0), "Peak memory limit in MB (0 for no limit).")
             ;
 
         po::variables_map vm;
@@ -62,6 +102,26 @@ public:
         planLength = vm["planLength"].as<unsigned int>();
         optimal = vm.count("optimal");
         incremental = vm.count("incremental");
+        step_slots = vm["step-slots"].as<unsigned int>();
+        sat_log_encoding = vm["sat-log-encoding"].as<int>();
+        stubborn_sets = vm.count("stubborn-sets");
+        orbit_search = vm.count("orbit-search");
+        grounding_threshold = vm["grounding-threshold"].as<int>();
+        beam_width = vm["beam-width"].as<int>();
+        alternation_heuristics = vm["alternation-heuristics"].as<std::string>();
+        lazy_evaluation = vm.count("lazy-evaluation");
+        cache_instantiations = vm.count("cache-instantiations");
+        invariants = vm.count("invariants");
+        postprocess_plan = vm.count("postprocess-plan");
+        checkpoint_file = vm["checkpoint-file"].as<std::string>();
+        checkpoint_interval = vm["checkpoint-interval"].as<double>();
+        resume = vm.count("resume");
+        telemetry_file = vm["telemetry-file"].as<std::string>();
+        telemetry_interval = vm["telemetry-interval"].as<double>();
+        telemetry_expansions = vm["telemetry-expansions"].as<long long>();
+        time_limit = vm["time-limit"].as<double>();
+        cpu_time_limit = vm["cpu-time-limit"].as<double>();
+        memory_limit = vm["memory-limit"].as<int>();
     }
 
     const std::string &get_filename() const {
@@ -104,6 +164,86 @@ public:
         return incremental;
     }
 
+    unsigned int get_step_slots() const {
+        return step_slots;
+    }
+
+    int get_sat_log_encoding() const {
+        return sat_log_encoding;
+    }
+
+    bool get_stubborn_sets() const {
+        return stubborn_sets;
+    }
+
+    bool get_orbit_search() const {
+        return orbit_search;
+    }
+
+    int get_grounding_threshold() const {
+        return grounding_threshold;
+    }
+
+    int get_beam_width() const {
+        return beam_width;
+    }
+
+    const std::string &get_alternation_heuristics() const {
+        return alternation_heuristics;
+    }
+
+    bool get_lazy_evaluation() const {
+        return lazy_evaluation;
+    }
+
+    bool get_cache_instantiations() const {
+        return cache_instantiations;
+    }
+
+    bool get_invariants() const {
+        return invariants;
+    }
+
+    bool get_postprocess_plan() const {
+        return postprocess_plan;
+    }
+
+    const std::string &get_checkpoint_file() const {
+        return checkpoint_file;
+    }
+
+    double get_checkpoint_interval() const {
+        return checkpoint_interval;
+    }
+
+    bool get_resume() const {
+        return resume;
+    }
+
+    const std::string &get_telemetry_file() const {
+        return telemetry_file;
+    }
+
+    double get_telemetry_interval() const {
+        return telemetry_interval;
+    }
+
+    long long get_telemetry_expansions() const {
+        return telemetry_expansions;
+    }
+
+    double get_time_limit() const {
+        return time_limit;
+    }
+
+    double get_cpu_time_limit() const {
+        return cpu_time_limit;
+    }
+
+    int get_memory_limit() const {
+        return memory_limit;
+    }
+
 
 };
 
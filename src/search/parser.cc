@@ -82,9 +82,49 @@ bool parse(Task &task, const ifstream &in)
     cout << "Total number of action schemas: " << number_action_schemas << endl;
     parse_action_schemas(task, number_action_schemas);
 
+    // Optional section (older translator outputs do not have it)
+    int number_reachable_schemas;
+    if (cin >> canary >> number_reachable_schemas) {
+        if (not is_next_section_correct(canary, "REACHABLE-PARAMETERS")) {
+            return false;
+        }
+        if (number_reachable_schemas != number_action_schemas) {
+            cerr << "Number of action schemas in section REACHABLE-PARAMETERS does not match"
+                 << endl;
+            return false;
+        }
+        parse_reachable_parameters(task, number_reachable_schemas);
+    }
+
     return true;
 }
 
+void parse_reachable_parameters(Task &task, int number_action_schemas)
+{
+    for (int i = 0; i < number_action_schemas; ++i) {
+        string name;
+        int number_parameters;
+        cin >> name >> number_parameters;
+        ActionSchema &action = task.actions[i];
+        if (name != action.get_name() or
+            number_parameters != int(action.get_parameters().size())) {
+            cerr << "Error while reading reachable parameters of action schema " << name << endl;
+            exit(-1);
+        }
+        vector<vector<int>> reachable_objects(number_parameters);
+        for (int j = 0; j < number_parameters; ++j) {
+            int number_objects;
+            cin >> number_objects;
+            if (number_objects < 0)
+                continue;
+            copy_next_n_values(number_objects, reachable_objects[j]);
+            if (number_objects == 0)
+                reachable_objects[j].push_back(-1);
+        }
+        action.set_reachable_objects(move(reachable_objects));
+    }
+}
+
 void parse_action_schemas(Task &task, int number_action_schemas)
 {
     vector<ActionSchema> actions;
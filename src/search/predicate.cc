@@ -13,6 +13,14 @@ bool Predicate::isStaticPredicate() const {
     return static_predicate;
 }
 
+bool Predicate::isRelevant() const {
+    return relevant;
+}
+
+void Predicate::setRelevant(bool value) {
+    relevant = value;
+}
+
 const std::string &Predicate::getName() const {
     return name;
 }
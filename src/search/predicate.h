@@ -27,12 +27,19 @@ public:
 
   bool isStaticPredicate() const;
 
+  // A predicate is irrelevant if it is fluent and never read by the goal nor by any
+  // relevant action schema (see relevance_analysis.h)
+  bool isRelevant() const;
+
+  void setRelevant(bool value);
+
 private:
   std::string name;
   int index;
   int arity;
   bool static_predicate;
   std::vector<int> types;
+  bool relevant = true;
 };
 
 #endif // SEARCH_PREDICATE_H
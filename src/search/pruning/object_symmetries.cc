@@ -0,0 +1,244 @@
+#include "object_symmetries.h"
+
+#include "../action_schema.h"
+#include "../task.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <vector>
+
+using namespace std;
+
+static vector<int> fact_key(int kind, int predicate, const GroundAtom &args)
+{
+    vector<int> key;
+    key.reserve(args.size() + 2);
+    key.push_back(kind);
+    key.push_back(predicate);
+    key.insert(key.end(), args.begin(), args.end());
+    return key;
+}
+
+ObjectSymmetries::ObjectSymmetries(const Task &task) :
+    packer(task),
+    symmetry_class(task.objects.size(), -1),
+    number_refinement_rounds(0)
+{
+    vector<Fact> facts;
+    for (const Relation &r : task.get_static_info().get_relations()) {
+        if (!task.predicates[r.predicate_symbol].isStaticPredicate())
+            continue;
+        for (const GroundAtom &tuple : r.tuples) {
+            facts.push_back({0, r.predicate_symbol, tuple});
+        }
+    }
+    for (const AtomicGoal &g : task.goal.goal) {
+        if (g.args.empty())
+            continue;
+        facts.push_back({g.negated ? 2 : 1, g.predicate, g.args});
+    }
+
+    vector<vector<int>> facts_of_object(task.objects.size());
+    unordered_set<vector<int>, TupleHash> fact_set;
+    for (size_t i = 0; i < facts.size(); ++i) {
+        for (int o : facts[i].args) {
+            if (facts_of_object[o].empty() or facts_of_object[o].back() != int(i))
+                facts_of_object[o].push_back(i);
+        }
+        fact_set.insert(fact_key(facts[i].kind, facts[i].predicate, facts[i].args));
+    }
+
+    vector<int> colors = compute_colors(task, facts, facts_of_object);
+
+    map<int, vector<int>> color_classes;
+    for (size_t o = 0; o < colors.size(); ++o) {
+        color_classes[colors[o]].push_back(o);
+    }
+
+    for (const auto &entry : color_classes) {
+        // Each component is identified by its first object. Transpositions are
+        // automorphisms of the task if they map the fact set to itself.
+        vector<vector<int>> components;
+        for (int o : entry.second) {
+            bool merged = false;
+            for (auto &component : components) {
+                if (is_automorphism(component[0], o, facts, facts_of_object, fact_set)) {
+                    component.push_back(o);
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged)
+                components.push_back({o});
+        }
+        for (auto &component : components) {
+            if (component.size() < 2)
+                continue;
+            for (int o : component)
+                symmetry_class[o] = classes.size();
+            classes.push_back(move(component));
+        }
+    }
+}
+
+/*
+ * Color refinement over the graph connecting objects with the facts they appear in.
+ * Objects with different colors cannot be mapped to each other by an automorphism.
+ */
+vector<int> ObjectSymmetries::compute_colors(const Task &task,
+                                             const vector<Fact> &facts,
+                                             const vector<vector<int>> &facts_of_object)
+{
+    size_t number_objects = task.objects.size();
+    vector<bool> is_constant(number_objects, false);
+    for (const ActionSchema &schema : task.actions) {
+        for (const auto *atoms : {&schema.get_precondition(), &schema.get_effects()}) {
+            for (const Atom &atom : *atoms) {
+                for (const Argument &arg : atom.arguments) {
+                    if (arg.constant)
+                        is_constant[arg.index] = true;
+                }
+            }
+        }
+    }
+
+    vector<int> colors(number_objects);
+    map<vector<int>, int> initial_colors;
+    for (size_t o = 0; o < number_objects; ++o) {
+        vector<int> key;
+        if (is_constant[o]) {
+            key = {-1, int(o)};
+        }
+        else {
+            key = task.objects[o].getTypes();
+            sort(key.begin(), key.end());
+        }
+        auto it = initial_colors.emplace(key, initial_colors.size()).first;
+        colors[o] = it->second;
+    }
+
+    size_t number_colors = initial_colors.size();
+    while (number_colors < number_objects) {
+        ++number_refinement_rounds;
+        map<pair<int, vector<vector<int>>>, int> refined_colors;
+        vector<int> new_colors(number_objects);
+        for (size_t o = 0; o < number_objects; ++o) {
+            vector<vector<int>> signature;
+            for (int f : facts_of_object[o]) {
+                const Fact &fact = facts[f];
+                for (size_t p = 0; p < fact.args.size(); ++p) {
+                    if (fact.args[p] != int(o))
+                        continue;
+                    vector<int> entry = {fact.kind, fact.predicate, int(p)};
+                    for (int arg : fact.args)
+                        entry.push_back(colors[arg]);
+                    signature.push_back(move(entry));
+                }
+            }
+            sort(signature.begin(), signature.end());
+            auto key = make_pair(colors[o], move(signature));
+            auto it = refined_colors.emplace(move(key), refined_colors.size()).first;
+            new_colors[o] = it->second;
+        }
+        colors = move(new_colors);
+        if (refined_colors.size() == number_colors)
+            break;
+        number_colors = refined_colors.size();
+    }
+    return colors;
+}
+
+bool ObjectSymmetries::is_automorphism(int a, int b,
+                                       const vector<Fact> &facts,
+                                       const vector<vector<int>> &facts_of_object,
+                                       const unordered_set<vector<int>, TupleHash> &fact_set)
+{
+    for (int o : {a, b}) {
+        for (int f : facts_of_object[o]) {
+            const Fact &fact = facts[f];
+            GroundAtom swapped = fact.args;
+            for (int &arg : swapped) {
+                if (arg == a)
+                    arg = b;
+                else if (arg == b)
+                    arg = a;
+            }
+            if (fact_set.count(fact_key(fact.kind, fact.predicate, swapped)) == 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+SparsePackedState ObjectSymmetries::canonical_state(const SparsePackedState &state) const
+{
+    vector<vector<GroundAtom>> tuples(state.packed_relations.size());
+    vector<vector<vector<int>>> signatures(symmetry_class.size());
+    for (size_t i = 0; i < state.packed_relations.size(); ++i) {
+        int predicate = state.predicate_symbols[i];
+        tuples[i].reserve(state.packed_relations[i].size());
+        for (long code : state.packed_relations[i]) {
+            tuples[i].push_back(packer.unpack_tuple(code, predicate));
+            const GroundAtom &tuple = tuples[i].back();
+            for (size_t p = 0; p < tuple.size(); ++p) {
+                if (symmetry_class[tuple[p]] == -1)
+                    continue;
+                vector<int> entry = {predicate, int(p)};
+                for (int arg : tuple) {
+                    int c = symmetry_class[arg];
+                    entry.push_back(c == -1 ? arg : -c - 1);
+                }
+                signatures[tuple[p]].push_back(move(entry));
+            }
+        }
+    }
+
+    vector<int> renaming(symmetry_class.size());
+    iota(renaming.begin(), renaming.end(), 0);
+    bool is_identity = true;
+    for (const auto &symmetry_class_objects : classes) {
+        vector<int> order = symmetry_class_objects;
+        for (int o : order)
+            sort(signatures[o].begin(), signatures[o].end());
+        stable_sort(order.begin(), order.end(), [&](int x, int y) {
+            return signatures[x] < signatures[y];
+        });
+        for (size_t k = 0; k < order.size(); ++k) {
+            renaming[order[k]] = symmetry_class_objects[k];
+            if (order[k] != symmetry_class_objects[k])
+                is_identity = false;
+        }
+    }
+    if (is_identity)
+        return state;
+
+    SparsePackedState canonical;
+    canonical.predicate_symbols = state.predicate_symbols;
+    canonical.nullary_atoms = state.nullary_atoms;
+    canonical.packed_relations.reserve(tuples.size());
+    for (size_t i = 0; i < tuples.size(); ++i) {
+        vector<long> packed_relation;
+        packed_relation.reserve(tuples[i].size());
+        for (GroundAtom &tuple : tuples[i]) {
+            for (int &arg : tuple)
+                arg = renaming[arg];
+            packed_relation.push_back(packer.pack_tuple(tuple, state.predicate_symbols[i]));
+        }
+        sort(packed_relation.begin(), packed_relation.end());
+        canonical.packed_relations.push_back(move(packed_relation));
+    }
+    return canonical;
+}
+
+void ObjectSymmetries::print_statistics() const
+{
+    size_t symmetric_objects = 0;
+    for (const auto &c : classes)
+        symmetric_objects += c.size();
+    cout << "Color refinement rounds: " << number_refinement_rounds << endl;
+    cout << "Object symmetry classes: " << classes.size()
+         << " (" << symmetric_objects << " interchangeable objects)" << endl;
+}
@@ -0,0 +1,79 @@
+#ifndef SEARCH_OBJECT_SYMMETRIES_H
+#define SEARCH_OBJECT_SYMMETRIES_H
+
+#include "../structures.h"
+#include "../states/sparse_states.h"
+
+#include <unordered_set>
+#include <vector>
+
+class Task;
+
+/**
+ * @brief Detect interchangeable objects of the task and map sparse packed states to
+ * a canonical representative of their orbit.
+ *
+ * @details Objects are interchangeable if swapping them maps the static information,
+ * the goal and the action schemas to themselves. Such a swap is an automorphism of the
+ * state space that preserves goal states. We find them with a search on the colored
+ * graph connecting objects to the static and goal atoms where they occur:
+ *    1. Color refinement starting from the object types (objects used as constants in
+ *    the action schemas get a unique color), until the coloring is stable.
+ *    2. Inside each color class, we check which transpositions are automorphisms.
+ *    Objects connected by valid transpositions form a symmetry class, and every
+ *    permutation of a symmetry class is an automorphism.
+ * The initial state is not required to be symmetric, as orbit search only uses the
+ * symmetries to detect duplicates among the generated states.
+ *
+ * The canonical representative of a state is computed directly from the packed codes:
+ * the objects of each symmetry class are sorted by the atoms where they occur in the
+ * state (with objects of symmetry classes abstracted to their class) and renamed in
+ * that order. States with the same representative are symmetric. The converse only
+ * holds if no two objects of a class are tied, so some symmetric states might still be
+ * considered different.
+ *
+ * See Domshlak, Katz and Shleyfer, ICAPS 2012, and Pochter, Zohar and Rosenschein,
+ * AAAI 2011, for symmetry-based pruning in the ground setting.
+ */
+class ObjectSymmetries {
+    SparseStatePacker packer;
+
+    // symmetry_class[o] is the index of the symmetry class of object o, or -1 if it
+    // is only interchangeable with itself. Classes are sorted by object index.
+    std::vector<int> symmetry_class;
+    std::vector<std::vector<int>> classes;
+
+    int number_refinement_rounds;
+
+    /*
+     * A static or goal atom of the task. 'kind' distinguishes static atoms (0),
+     * positive goals (1) and negative goals (2).
+     */
+    struct Fact {
+        int kind;
+        int predicate;
+        GroundAtom args;
+    };
+
+    std::vector<int> compute_colors(const Task &task,
+                                    const std::vector<Fact> &facts,
+                                    const std::vector<std::vector<int>> &facts_of_object);
+
+    static bool is_automorphism(int a, int b,
+                                const std::vector<Fact> &facts,
+                                const std::vector<std::vector<int>> &facts_of_object,
+                                const std::unordered_set<std::vector<int>, TupleHash> &fact_set);
+
+public:
+    explicit ObjectSymmetries(const Task &task);
+
+    bool empty() const {
+        return classes.empty();
+    }
+
+    SparsePackedState canonical_state(const SparsePackedState &state) const;
+
+    void print_statistics() const;
+};
+
+#endif //SEARCH_OBJECT_SYMMETRIES_H
@@ -0,0 +1,324 @@
+#include "stubborn_sets.h"
+
+#include "../action_schema.h"
+#include "../task.h"
+
+#include "../successor_generators/successor_generator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Two lifted atoms of (possibly) different schemas unify if they have the same
+ * predicate symbol and agree on every argument position where both have a constant.
+ */
+static bool unifies(const Atom &a, const Atom &b)
+{
+    if (a.predicate_symbol != b.predicate_symbol)
+        return false;
+    assert(a.arguments.size() == b.arguments.size());
+    for (size_t i = 0; i < a.arguments.size(); ++i) {
+        const Argument &x = a.arguments[i];
+        const Argument &y = b.arguments[i];
+        if (x.constant and y.constant and x.index != y.index)
+            return false;
+    }
+    return true;
+}
+
+static bool unifies(const Atom &a, int predicate, const vector<int> &args)
+{
+    if (a.predicate_symbol != predicate)
+        return false;
+    for (size_t i = 0; i < a.arguments.size(); ++i) {
+        if (a.arguments[i].constant and a.arguments[i].index != args[i])
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Check whether some effect of the given polarity of the action unifies with the atom.
+ */
+static bool has_effect_on(const ActionSchema &action, const Atom &atom, bool negated)
+{
+    for (const Atom &eff : action.get_effects()) {
+        if (eff.negated == negated and unifies(eff, atom))
+            return true;
+    }
+    return false;
+}
+
+static bool has_nullary_effect_on(const ActionSchema &action, int predicate, bool negated)
+{
+    return negated ? action.get_negative_nullary_effects()[predicate]
+                   : action.get_positive_nullary_effects()[predicate];
+}
+
+StubbornSets::StubbornSets(const Task &task) :
+    task(task), number_of_calls(0), number_of_stubborn_schemas(0)
+{
+    compute_achievers();
+    compute_interference();
+    stubborn.resize(task.actions.size(), false);
+    applicable.resize(task.actions.size());
+}
+
+void StubbornSets::compute_achievers()
+{
+    const auto &actions = task.actions;
+    requirements.resize(actions.size());
+    for (const ActionSchema &action : actions) {
+        auto &reqs = requirements[action.get_index()];
+        // Nullary requirements first: they are cheap to check and, if violated, they are
+        // violated by all instantiations
+        for (size_t p = 0; p < task.predicates.size(); ++p) {
+            for (bool negated : {false, true}) {
+                bool required = negated ? action.get_negative_nullary_precond()[p]
+                                        : action.get_positive_nullary_precond()[p];
+                if (!required)
+                    continue;
+                Requirement r{nullptr, int(p), negated, {}};
+                for (const ActionSchema &other : actions) {
+                    // A negated precondition is achieved by deleting the atom
+                    if (has_nullary_effect_on(other, p, negated))
+                        r.achievers.push_back(other.get_index());
+                }
+                reqs.push_back(move(r));
+            }
+        }
+        for (const Atom &pre : action.get_precondition()) {
+            if (pre.name == "=" or task.predicates[pre.predicate_symbol].isStaticPredicate())
+                continue;
+            Requirement r{&pre, -1, pre.negated, {}};
+            for (const ActionSchema &other : actions) {
+                if (has_effect_on(other, pre, pre.negated))
+                    r.achievers.push_back(other.get_index());
+            }
+            reqs.push_back(move(r));
+        }
+    }
+
+    for (const AtomicGoal &g : task.goal.goal) {
+        goal_achievers.emplace_back();
+        for (const ActionSchema &action : actions) {
+            for (const Atom &eff : action.get_effects()) {
+                if (eff.negated == g.negated and unifies(eff, g.predicate, g.args)) {
+                    goal_achievers.back().push_back(action.get_index());
+                    break;
+                }
+            }
+        }
+    }
+    for (bool negated : {false, true}) {
+        const auto &nullary_goals = negated ? task.goal.negative_nullary_goals
+                                            : task.goal.positive_nullary_goals;
+        for (int p : nullary_goals) {
+            goal_achievers.emplace_back();
+            for (const ActionSchema &action : actions) {
+                if (has_nullary_effect_on(action, p, negated))
+                    goal_achievers.back().push_back(action.get_index());
+            }
+        }
+    }
+}
+
+/*
+ * Two schemas interfere if one can disable the other (deleting one of its preconditions
+ * or adding one of its negated preconditions) or if they have conflicting effects.
+ */
+static bool disables(const ActionSchema &a, const ActionSchema &b)
+{
+    for (const Atom &pre : b.get_precondition()) {
+        if (pre.name == "=")
+            continue;
+        if (has_effect_on(a, pre, !pre.negated))
+            return true;
+    }
+    for (size_t p = 0; p < b.get_positive_nullary_precond().size(); ++p) {
+        if ((b.get_positive_nullary_precond()[p] and a.get_negative_nullary_effects()[p]) or
+            (b.get_negative_nullary_precond()[p] and a.get_positive_nullary_effects()[p]))
+            return true;
+    }
+    return false;
+}
+
+static bool have_conflicting_effects(const ActionSchema &a, const ActionSchema &b)
+{
+    for (const Atom &eff : a.get_effects()) {
+        if (has_effect_on(b, eff, !eff.negated))
+            return true;
+    }
+    for (size_t p = 0; p < a.get_positive_nullary_effects().size(); ++p) {
+        if ((a.get_positive_nullary_effects()[p] and b.get_negative_nullary_effects()[p]) or
+            (a.get_negative_nullary_effects()[p] and b.get_positive_nullary_effects()[p]))
+            return true;
+    }
+    return false;
+}
+
+void StubbornSets::compute_interference()
+{
+    const auto &actions = task.actions;
+    interfering_schemas.resize(actions.size());
+    for (const ActionSchema &a : actions) {
+        for (const ActionSchema &b : actions) {
+            if (a.get_index() == b.get_index())
+                continue;
+            if (disables(a, b) or disables(b, a) or have_conflicting_effects(a, b))
+                interfering_schemas[a.get_index()].push_back(b.get_index());
+        }
+    }
+}
+
+/*
+ * Return the achievers of the unsatisfied goal atom with fewest achievers, or nullptr if
+ * the goal is satisfied.
+ */
+const vector<int> *StubbornSets::get_unsatisfied_goal_achievers(const DBState &state) const
+{
+    const vector<int> *best = nullptr;
+    auto consider = [&best](const vector<int> &achievers) {
+        if (!best or achievers.size() < best->size())
+            best = &achievers;
+    };
+
+    size_t i = 0;
+    for (const AtomicGoal &g : task.goal.goal) {
+        bool holds = state.get_tuples_of_relation(g.predicate).count(g.args) > 0;
+        if (holds == g.negated)
+            consider(goal_achievers[i]);
+        ++i;
+    }
+    for (bool negated : {false, true}) {
+        const auto &nullary_goals = negated ? task.goal.negative_nullary_goals
+                                            : task.goal.positive_nullary_goals;
+        for (int p : nullary_goals) {
+            if (state.get_nullary_atoms()[p] == negated)
+                consider(goal_achievers[i]);
+            ++i;
+        }
+    }
+    return best;
+}
+
+static bool is_ground(const Atom &atom)
+{
+    return all_of(atom.arguments.begin(), atom.arguments.end(),
+                  [](const Argument &arg) { return arg.constant; });
+}
+
+static bool holds(const Atom &atom, const DBState &state)
+{
+    assert(is_ground(atom));
+    GroundAtom ga;
+    for (const Argument &arg : atom.arguments)
+        ga.push_back(arg.index);
+    return state.get_tuples_of_relation(atom.predicate_symbol).count(ga) > 0;
+}
+
+bool StubbornSets::is_satisfied_by_all(const Requirement &r, const DBState &state) const
+{
+    if (!r.atom)
+        return state.get_nullary_atoms()[r.nullary_predicate] != r.negated;
+    return is_ground(*r.atom) and holds(*r.atom, state) != r.negated;
+}
+
+bool StubbornSets::is_satisfied_by_none(const Requirement &r, const DBState &state) const
+{
+    if (!r.atom)
+        return state.get_nullary_atoms()[r.nullary_predicate] == r.negated;
+    if (is_ground(*r.atom))
+        return holds(*r.atom, state) == r.negated;
+    if (r.negated)
+        return false;
+    // A positive atom is satisfied by no instantiation if no tuple matches its constants
+    for (const GroundAtom &tuple : state.get_tuples_of_relation(r.atom->predicate_symbol)) {
+        bool match = true;
+        for (size_t i = 0; i < tuple.size() and match; ++i) {
+            const Argument &arg = r.atom->arguments[i];
+            match = !arg.constant or arg.index == tuple[i];
+        }
+        if (match)
+            return false;
+    }
+    return true;
+}
+
+void StubbornSets::compute_stubborn_set(const DBState &state, SuccessorGenerator &generator)
+{
+    ++number_of_calls;
+    fill(stubborn.begin(), stubborn.end(), false);
+    for (auto &ops : applicable)
+        ops.clear();
+
+    vector<int> queue;
+    auto enqueue = [&](const vector<int> &schemas) {
+        for (int s : schemas) {
+            if (!stubborn[s]) {
+                stubborn[s] = true;
+                queue.push_back(s);
+            }
+        }
+    };
+
+    const vector<int> *achievers = get_unsatisfied_goal_achievers(state);
+    if (achievers) {
+        enqueue(*achievers);
+    }
+    else {
+        // Goal state: no pruning at all
+        vector<int> all(task.actions.size());
+        for (size_t i = 0; i < all.size(); ++i)
+            all[i] = i;
+        enqueue(all);
+    }
+
+    while (!queue.empty()) {
+        int s = queue.back();
+        queue.pop_back();
+        const ActionSchema &action = task.actions[s];
+        applicable[s] = generator.get_applicable_actions(action, state);
+
+        if (!applicable[s].empty()) {
+            enqueue(interfering_schemas[s]);
+            // A ground schema has a single instantiation, which is applicable
+            if (action.is_ground())
+                continue;
+        }
+
+        // Necessary enabling sets for the inapplicable instantiations
+        for (const Requirement &r : requirements[s]) {
+            if (is_satisfied_by_all(r, state))
+                continue;
+            enqueue(r.achievers);
+            if (is_satisfied_by_none(r, state))
+                break;
+        }
+    }
+
+    number_of_stubborn_schemas += count(stubborn.begin(), stubborn.end(), true);
+}
+
+bool StubbornSets::is_stubborn(const ActionSchema &action) const
+{
+    return stubborn[action.get_index()];
+}
+
+vector<LiftedOperatorId> &StubbornSets::get_applicable_actions(const ActionSchema &action)
+{
+    assert(is_stubborn(action));
+    return applicable[action.get_index()];
+}
+
+void StubbornSets::print_statistics() const
+{
+    double average = number_of_calls ? double(number_of_stubborn_schemas) / number_of_calls : 0;
+    cout << "Stubborn set computations: " << number_of_calls << endl;
+    cout << "Average number of stubborn schemas: " << average
+         << " (out of " << task.actions.size() << ")" << endl;
+}
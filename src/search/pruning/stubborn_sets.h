@@ -0,0 +1,92 @@
+#ifndef SEARCH_STUBBORN_SETS_H
+#define SEARCH_STUBBORN_SETS_H
+
+#include "../action.h"
+
+#include <vector>
+
+class ActionSchema;
+class DBState;
+class SuccessorGenerator;
+class Task;
+struct Atom;
+
+/**
+ * @brief Partial-order reduction with strong stubborn sets computed at the level of
+ * action schemas.
+ *
+ * @details A schema in the stubborn set stands for all its instantiations. The
+ * achiever and interference relations between schemas are precomputed from their
+ * preconditions and effects, where two atoms are considered to unify if they have the
+ * same predicate and agree on the constants at each argument position. Then, for
+ * every expanded state, we start with the achievers of one unsatisfied goal atom and
+ * close the set under:
+ *    1. Interference: if some instantiation of the schema is applicable, add all
+ *    schemas interfering with it (disabling it, disabled by it, or with conflicting
+ *    effects).
+ *    2. Necessary enabling sets: add the achievers of the fluent preconditions of the
+ *    schema, in order, until reaching one that no instantiation satisfies in the state
+ *    (e.g., the predicate has no matching tuple). Preconditions satisfied by every
+ *    instantiation are skipped.
+ *
+ * Only the applicable instantiations of the stubborn schemas need to be expanded.
+ * They are computed while building the stubborn set and cached until the next call.
+ *
+ * See Wehrle and Helmert, ICAPS 2014, for strong stubborn sets in the ground setting.
+ */
+class StubbornSets {
+    /*
+     * A fluent precondition of a schema together with the schemas achieving it. If
+     * 'atom' is null, the requirement is over the nullary predicate 'nullary_predicate'.
+     */
+    struct Requirement {
+        const Atom *atom;
+        int nullary_predicate;
+        bool negated;
+        std::vector<int> achievers;
+    };
+
+    const Task &task;
+
+    std::vector<std::vector<Requirement>> requirements;
+    std::vector<std::vector<int>> interfering_schemas;
+
+    // Achievers for the atoms of the goal, in the same order as in the goal condition,
+    // followed by the positive and negative nullary goals
+    std::vector<std::vector<int>> goal_achievers;
+
+    std::vector<bool> stubborn;
+    std::vector<std::vector<LiftedOperatorId>> applicable;
+
+    long number_of_calls;
+    long number_of_stubborn_schemas;
+
+    void compute_achievers();
+    void compute_interference();
+
+    const std::vector<int> *get_unsatisfied_goal_achievers(const DBState &state) const;
+
+    bool is_satisfied_by_all(const Requirement &r, const DBState &state) const;
+    bool is_satisfied_by_none(const Requirement &r, const DBState &state) const;
+
+public:
+    explicit StubbornSets(const Task &task);
+
+    /**
+     * Compute a strong stubborn set for the given state, instantiating every schema in
+     * it with the successor generator.
+     */
+    void compute_stubborn_set(const DBState &state, SuccessorGenerator &generator);
+
+    bool is_stubborn(const ActionSchema &action) const;
+
+    /**
+     * Applicable instantiations of a stubborn schema in the state passed to the last
+     * call to compute_stubborn_set.
+     */
+    std::vector<LiftedOperatorId> &get_applicable_actions(const ActionSchema &action);
+
+    void print_statistics() const;
+};
+
+#endif //SEARCH_STUBBORN_SETS_H
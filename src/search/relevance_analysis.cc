@@ -0,0 +1,191 @@
+#include "relevance_analysis.h"
+
+#include "action_schema.h"
+#include "task.h"
+
+#include <iostream>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+/*
+ * A pattern is a list of object indices, one per argument position, where -1
+ * stands for any object.
+ */
+typedef vector<int> Pattern;
+typedef vector<set<Pattern>> PatternsPerPredicate;
+
+static const int ANY_OBJECT = -1;
+
+static Pattern atom_to_pattern(const Atom &atom)
+{
+    Pattern pattern;
+    pattern.reserve(atom.arguments.size());
+    for (const Argument &arg : atom.arguments) {
+        pattern.push_back(arg.constant ? arg.index : ANY_OBJECT);
+    }
+    return pattern;
+}
+
+/*
+ * Check if the (lifted) atom unifies with the pattern. A variable occurring
+ * several times in the atom must be mapped to the same object.
+ */
+static bool unifies(const Atom &atom, const Pattern &pattern, size_t num_parameters)
+{
+    vector<int> binding(num_parameters, ANY_OBJECT);
+    for (size_t i = 0; i < atom.arguments.size(); ++i) {
+        const Argument &arg = atom.arguments[i];
+        if (pattern[i] == ANY_OBJECT)
+            continue;
+        if (arg.constant) {
+            if (arg.index != pattern[i])
+                return false;
+        }
+        else {
+            if (binding[arg.index] != ANY_OBJECT and binding[arg.index] != pattern[i])
+                return false;
+            binding[arg.index] = pattern[i];
+        }
+    }
+    return true;
+}
+
+static bool unifies_with_some(const Atom &atom,
+                              const PatternsPerPredicate &patterns,
+                              size_t num_parameters)
+{
+    for (const Pattern &p : patterns[atom.predicate_symbol]) {
+        if (unifies(atom, p, num_parameters))
+            return true;
+    }
+    return false;
+}
+
+/*
+ * Check if the schema has some effect making true an atom read positively, or false
+ * an atom read negatively.
+ */
+static bool is_relevant(const ActionSchema &action,
+                        const PatternsPerPredicate &positive,
+                        const PatternsPerPredicate &negative,
+                        const vector<bool> &positive_nullary,
+                        const vector<bool> &negative_nullary)
+{
+    size_t num_parameters = action.get_parameters().size();
+    for (const Atom &eff : action.get_effects()) {
+        const auto &patterns = eff.negated ? negative : positive;
+        if (unifies_with_some(eff, patterns, num_parameters))
+            return true;
+    }
+    for (size_t i = 0; i < positive_nullary.size(); ++i) {
+        if ((action.get_positive_nullary_effects()[i] and positive_nullary[i]) or
+            (action.get_negative_nullary_effects()[i] and negative_nullary[i]))
+            return true;
+    }
+    return false;
+}
+
+void prune_irrelevant_schemas(Task &task)
+{
+    size_t num_predicates = task.predicates.size();
+    PatternsPerPredicate positive(num_predicates), negative(num_predicates);
+    vector<bool> positive_nullary(num_predicates, false), negative_nullary(num_predicates, false);
+
+    for (const AtomicGoal &g : task.goal.goal) {
+        auto &patterns = g.negated ? negative : positive;
+        patterns[g.predicate].insert(g.args);
+    }
+    for (int p : task.goal.positive_nullary_goals)
+        positive_nullary[p] = true;
+    for (int p : task.goal.negative_nullary_goals)
+        negative_nullary[p] = true;
+
+    // Fixpoint: add the preconditions of every new relevant schema as patterns
+    vector<bool> relevant(task.actions.size(), false);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 0; i < task.actions.size(); ++i) {
+            const ActionSchema &action = task.actions[i];
+            if (relevant[i] or
+                !is_relevant(action, positive, negative, positive_nullary, negative_nullary))
+                continue;
+            relevant[i] = true;
+            changed = true;
+            for (const Atom &pre : action.get_precondition()) {
+                if (pre.name == "=")
+                    continue;
+                auto &patterns = pre.negated ? negative : positive;
+                patterns[pre.predicate_symbol].insert(atom_to_pattern(pre));
+            }
+            for (size_t p = 0; p < num_predicates; ++p) {
+                positive_nullary[p] = positive_nullary[p] or action.get_positive_nullary_precond()[p];
+                negative_nullary[p] = negative_nullary[p] or action.get_negative_nullary_precond()[p];
+            }
+        }
+    }
+
+    // Keep relevant schemas (re-indexed) and only their effects on atoms that are read
+    vector<ActionSchema> actions;
+    size_t removed_effects = 0;
+    for (size_t i = 0; i < task.actions.size(); ++i) {
+        if (!relevant[i])
+            continue;
+        const ActionSchema &action = task.actions[i];
+        size_t num_parameters = action.get_parameters().size();
+        vector<Atom> effects;
+        for (const Atom &eff : action.get_effects()) {
+            if (unifies_with_some(eff, positive, num_parameters) or
+                unifies_with_some(eff, negative, num_parameters)) {
+                effects.push_back(eff);
+            }
+            else {
+                ++removed_effects;
+            }
+        }
+        vector<bool> positive_nullary_effects(action.get_positive_nullary_effects());
+        vector<bool> negative_nullary_effects(action.get_negative_nullary_effects());
+        for (size_t p = 0; p < num_predicates; ++p) {
+            if (positive_nullary[p] or negative_nullary[p])
+                continue;
+            removed_effects += positive_nullary_effects[p] + negative_nullary_effects[p];
+            positive_nullary_effects[p] = negative_nullary_effects[p] = false;
+        }
+        actions.emplace_back(action.get_name(),
+                             actions.size(),
+                             action.get_cost(),
+                             action.get_parameters(),
+                             action.get_precondition(),
+                             move(effects),
+                             action.get_inequalities(),
+                             action.get_positive_nullary_precond(),
+                             action.get_negative_nullary_precond(),
+                             move(positive_nullary_effects),
+                             move(negative_nullary_effects));
+        actions.back().set_reachable_objects(action.get_reachable_objects());
+    }
+    size_t removed_schemas = task.actions.size() - actions.size();
+    task.initialize_action_schemas(actions);
+
+    // Fluent predicates that are never read do not need to be part of the state
+    vector<Relation> relations(task.initial_state.get_relations());
+    vector<bool> nullary_atoms(task.initial_state.get_nullary_atoms());
+    size_t irrelevant_predicates = 0;
+    for (size_t p = 0; p < num_predicates; ++p) {
+        Predicate &pred = task.predicates[p];
+        if (pred.isStaticPredicate() or !positive[p].empty() or !negative[p].empty() or
+            positive_nullary[p] or negative_nullary[p])
+            continue;
+        pred.setRelevant(false);
+        relations[p].tuples.clear();
+        nullary_atoms[p] = false;
+        ++irrelevant_predicates;
+    }
+    task.initial_state = DBState(move(relations), move(nullary_atoms));
+
+    cout << "Relevance analysis removed " << removed_schemas << " action schema(s), "
+         << removed_effects << " effect(s) and " << irrelevant_predicates
+         << " fluent predicate(s)" << endl;
+}
@@ -0,0 +1,26 @@
+#ifndef SEARCH_RELEVANCE_ANALYSIS_H
+#define SEARCH_RELEVANCE_ANALYSIS_H
+
+class Task;
+
+/**
+ * @brief Lifted backward relevance analysis. Remove from the task all action schemas
+ * that cannot contribute to the goal, the effects nobody reads, and the atoms of fluent
+ * predicates nobody reads.
+ *
+ * @details Relevance is computed as a fixpoint over atom patterns, i.e., a predicate
+ * symbol together with the constants at each argument position (or a wildcard), kept
+ * separately for atoms that are read positively and negatively. The goal atoms are the
+ * initial patterns. A schema is relevant if one of its add effects unifies with a
+ * positive pattern, or one of its delete effects with a negative one; the preconditions
+ * of relevant schemas become new patterns. Removing the remaining schemas from a plan
+ * keeps it valid, since they can only make atoms that are read false (resp. true if read
+ * negated), or modify atoms that are never read.
+ *
+ * Effects of relevant schemas that do not unify with any pattern (of either polarity)
+ * are dropped. Fluent predicates without any pattern are marked as irrelevant and their
+ * atoms are removed from the initial state. Schemas are re-indexed afterwards.
+ */
+void prune_irrelevant_schemas(Task &task);
+
+#endif //SEARCH_RELEVANCE_ANALYSIS_H
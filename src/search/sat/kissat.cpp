@@ -2,6 +2,18 @@
 #include "kissat.h"
 #include <stdio.h>
 #include <cstdlib>
+#include <vector>
+
+// kissat can solve a formula only once. To support incremental solving, all clauses are kept and every
+// call of ipasir_solve solves them with a new kissat instance, with the assumptions added as unit clauses.
+// The result is the same as with an incremental solver, but nothing learnt is kept between the calls.
+struct kissat_ipasir {
+	std::vector<int> clauses;
+	std::vector<int> assumptions;
+	kissat * solver = nullptr;
+	void * terminate_state = nullptr;
+	int (*terminate)(void * state) = nullptr;
+};
 
 extern "C" {
 
@@ -22,7 +34,7 @@ IPASIR_API const char * ipasir_signature (){
  * State after: INPUT
  */
 IPASIR_API void * ipasir_init (){
-	return kissat_init();
+	return new kissat_ipasir();
 }
 
 /**
@@ -34,7 +46,10 @@ IPASIR_API void * ipasir_init (){
  * State after: undefined
  */
 IPASIR_API void ipasir_release (void * solver){
-	return kissat_release((kissat*)solver);
+	kissat_ipasir * wrapper = (kissat_ipasir*)solver;
+	if (wrapper->solver)
+		kissat_release(wrapper->solver);
+	delete wrapper;
 }
 
 /**
@@ -53,7 +68,7 @@ IPASIR_API void ipasir_release (void * solver){
  * arguments in API functions.
  */
 IPASIR_API void ipasir_add (void * solver, int lit_or_zero){
-	kissat_add((kissat*)solver,lit_or_zero);
+	((kissat_ipasir*)solver)->clauses.push_back(lit_or_zero);
 }
 
 /**
@@ -65,8 +80,7 @@ IPASIR_API void ipasir_add (void * solver, int lit_or_zero){
  * State after: INPUT
  */
 IPASIR_API void ipasir_assume (void * solver, int lit){
-	printf("Not supported by kissat\n");
-	exit(0);
+	((kissat_ipasir*)solver)->assumptions.push_back(lit);
 }
 
 /**
@@ -80,7 +94,21 @@ IPASIR_API void ipasir_assume (void * solver, int lit){
  * State after: INPUT or SAT or UNSAT
  */
 IPASIR_API int ipasir_solve (void * solver){
-	return kissat_solve((kissat*)solver);
+	kissat_ipasir * wrapper = (kissat_ipasir*)solver;
+	if (wrapper->solver)
+		kissat_release(wrapper->solver);
+	wrapper->solver = kissat_init();
+	if (wrapper->terminate)
+		kissat_set_terminate(wrapper->solver, wrapper->terminate_state, wrapper->terminate);
+
+	for (int lit : wrapper->clauses)
+		kissat_add(wrapper->solver, lit);
+	for (int lit : wrapper->assumptions){
+		kissat_add(wrapper->solver, lit);
+		kissat_add(wrapper->solver, 0);
+	}
+	wrapper->assumptions.clear();
+	return kissat_solve(wrapper->solver);
 }
 
 /**
@@ -94,6 +122,22 @@ IPASIR_API int ipasir_solve (void * solver){
  * State after: SAT
  */
 IPASIR_API int ipasir_val (void * solver, int lit){
-	return kissat_value((kissat*)solver,lit);
+	return kissat_value(((kissat_ipasir*)solver)->solver,lit);
+}
+
+/**
+ * Set a callback function used to indicate a termination requirement to the
+ * solver. The solver will periodically call this function and check its return
+ * value during the search.
+ *
+ * Required state: INPUT or SAT or UNSAT
+ * State after: INPUT or SAT or UNSAT
+ */
+IPASIR_API void ipasir_set_terminate (void * solver, void * state, int (*terminate)(void * state)){
+	kissat_ipasir * wrapper = (kissat_ipasir*)solver;
+	wrapper->terminate_state = state;
+	wrapper->terminate = terminate;
+	if (wrapper->solver)
+		kissat_set_terminate(wrapper->solver, state, terminate);
 }
 }
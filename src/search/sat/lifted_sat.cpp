@@ -11,6 +11,7 @@
 #include <cassert>
 #include <chrono>
 #include <iomanip>
+#include <algorithm>
 
 using namespace std;
 
@@ -21,6 +22,7 @@ map<int,int> typeOfArgument;
 
 vector<vector<vector<pair<vector<int>,int>>>> supportingTuples; // action -> precondition
 vector<vector<vector<pair<vector<int>,int>>>> deletedTuples; // action -> precondition
+vector<vector<StaticTableMDD*>> staticTableMDDs; // action -> precondition, nullptr if not compiled
 
 
 LiftedSAT::LiftedSAT(const Task & task) {
@@ -142,6 +144,26 @@ LiftedSAT::LiftedSAT(const Task & task) {
         }
     }
 
+    // check whether an argument of a precondition and an argument of an effect can be the same object
+    unordered_set<int>* parentsOf = parents;
+    auto argumentsCompatible = [&](const ActionSchema & consumer, const Argument & p,
+                                   const ActionSchema & producer, const Argument & e) {
+        if (p.constant && e.constant) return p.index == e.index;
+        if (p.constant) {
+            int typeE = producer.get_parameters()[e.index].type;
+            return types[typeE].find(p.index) != types[typeE].end();
+        }
+        if (e.constant) {
+            int typeP = consumer.get_parameters()[p.index].type;
+            return types[typeP].find(e.index) != types[typeP].end();
+        }
+        int typeP = consumer.get_parameters()[p.index].type;
+        int typeE = producer.get_parameters()[e.index].type;
+        if (typeP == typeE) return true;
+        if (parentsOf[typeP].find(typeE) != parentsOf[typeP].end()) return true;
+        return parentsOf[typeE].find(typeP) != parentsOf[typeE].end();
+    };
+
     cout << "- building achiever lookup tables..." << endl;
     // !!! this code assumes the non-sparse (i.e. transitively closed) typing !!!
     for (tSize iAction = 0; iAction < task.actions.size(); iAction++) {
@@ -170,33 +192,10 @@ LiftedSAT::LiftedSAT(const Task & task) {
                          */
                         bool typesCompatible = true;
                         for (tSize iArg = 0; iArg < prec.arguments.size(); iArg++) {
-                            int varP = prec.arguments[iArg].index;
-                            int varE = eff.arguments[iArg].index;
-                            const bool pIsConst = prec.arguments[iArg].constant;
-                            const bool eIsConst = eff.arguments[iArg].constant;
-                            if (pIsConst && eIsConst) {
-                                if (varP == varE) {
-                                    continue;
-                                }
-                            } else if (pIsConst) {
-                                int typeE = posAchAction.get_parameters()[varE].type;
-                                if (types[typeE].find(varP) != types[typeE].end()) {
-                                    continue;
-                                }
-                            } else if (eIsConst) {
-                                int typeP = consumer.get_parameters()[varP].type;
-                                if (types[typeP].find(varE) != types[typeP].end()) {
-                                    continue;
-                                }
-                            } else {
-                                int typeP = consumer.get_parameters()[varP].type;
-                                int typeE = posAchAction.get_parameters()[varE].type;
-                                if (typeP == typeE) continue;
-                                if (parents[typeP].find(typeE) != parents[typeP].end()) continue;
-                                if (parents[typeE].find(typeP) != parents[typeE].end()) continue;
+                            if (!argumentsCompatible(consumer, prec.arguments[iArg], posAchAction, eff.arguments[iArg])) {
+                                typesCompatible = false;
+                                break;
                             }
-                            typesCompatible = false;
-                            break;
                         }
                         if (typesCompatible) {
                             Achiever *ach = new Achiever;
@@ -244,6 +243,66 @@ LiftedSAT::LiftedSAT(const Task & task) {
         }
     }
 
+    // mutex groups: an action adding an atom of the same invariant instance as a precondition
+    // must delete the precondition (if it is true), so it destroys it. Only the positions of
+    // the precondition holding parameters of the invariant are constrained.
+    if (!task.invariants.empty()) {
+        cout << "- adding destroyers from mutex groups..." << endl;
+        int mutexDestroyers = 0;
+        for (tSize iAction = 0; iAction < task.actions.size(); iAction++) {
+            const auto & consumer = task.actions[iAction];
+            const auto & precs = consumer.get_precondition();
+            for (tSize iPrec = 0; iPrec < precs.size(); iPrec++) {
+                const auto & prec = precs[iPrec];
+                if (prec.negated) continue;
+                for (const Invariant & invariant : task.invariants) {
+                    const InvariantPart* precPart = invariant.find_part(prec.predicate_symbol);
+                    if (!precPart) continue;
+                    for (tSize iDes = 0; iDes < task.actions.size(); iDes++) {
+                        const auto & destroyer = task.actions[iDes];
+                        // nullary add effects are atoms without arguments
+                        vector<pair<int,const vector<Argument>*>> adds;
+                        const vector<Argument> noArguments;
+                        for (tSize ie = 0; ie < destroyer.get_effects().size(); ie++)
+                            if (!destroyer.get_effects()[ie].negated)
+                                adds.push_back({ie, &destroyer.get_effects()[ie].arguments});
+                        for (tSize n = 0; n < destroyer.get_positive_nullary_effects().size(); n++)
+                            if (destroyer.get_positive_nullary_effects()[n] && invariant.find_part(n))
+                                adds.push_back({-1 - int(n), &noArguments});
+
+                        for (auto & [ie, effArguments] : adds) {
+                            int effPredicate = ie >= 0 ? destroyer.get_effects()[ie].predicate_symbol : -1 - ie;
+                            const InvariantPart* effPart = invariant.find_part(effPredicate);
+                            if (!effPart) continue;
+
+                            Achiever *ach = new Achiever;
+                            ach->action = iDes;
+                            ach->effect = ie;
+                            ach->params.assign(prec.arguments.size(), ANY_PARAMETER);
+                            bool typesCompatible = true;
+                            for (tSize i = 0; i < precPart->order.size(); i++) {
+                                const Argument & precArg = prec.arguments[precPart->order[i]];
+                                const Argument & effArg = (*effArguments)[effPart->order[i]];
+                                if (!argumentsCompatible(consumer, precArg, destroyer, effArg)) {
+                                    typesCompatible = false;
+                                    break;
+                                }
+                                ach->params[precPart->order[i]] = effArg.constant ? (effArg.index + 1) * -1 : effArg.index;
+                            }
+                            if (!typesCompatible) {
+                                delete ach;
+                                continue;
+                            }
+                            achievers[iAction]->precAchievers[iPrec]->destroyers.push_back(ach);
+                            mutexDestroyers++;
+                        }
+                    }
+                }
+            }
+        }
+        cout << "  " << mutexDestroyers << " destroyers from mutex groups" << endl;
+    }
+
     // same for goals
     goalAchievers = new ActionPrecAchievers;
     for (tSize iGoal = 0; iGoal < task.goal.goal.size(); iGoal++) {
@@ -559,10 +618,15 @@ LiftedSAT::LiftedSAT(const Task & task) {
 
 	supportingTuples.resize(task.actions.size());
 	deletedTuples.resize(task.actions.size());
+	staticTableMDDs.resize(task.actions.size());
+	int staticTables = 0;
+	int compiledTables = 0;
+	int compiledNodes = 0;
 	for (size_t action = 0; action < task.actions.size(); action++){
         const auto precs = task.actions[action].get_precondition();
 		
 		supportingTuples[action].resize(precs.size());
+		staticTableMDDs[action].resize(precs.size(),nullptr);
         for (size_t prec = 0; prec < precs.size(); prec++) {
         	DEBUG(cout << "\t\tprecondition #" << prec << endl);
         	
@@ -634,6 +698,16 @@ LiftedSAT::LiftedSAT(const Task & task) {
 			    	mySupportingTuples.push_back({groundA,currentStartingPos++});
 			    }
 			}
+
+			// static tables with several arguments are compiled once and, if smaller, encoded as MDD in every step
+			if (task.predicates[predicate].isStaticPredicate() && precObjec.arguments.size() > 1 && mySupportingTuples.size() > 1){
+				staticTables++;
+				staticTableMDDs[action][prec] = compileStaticTable(action, precObjec, mySupportingTuples);
+				if (staticTableMDDs[action][prec]){
+					compiledTables++;
+					compiledNodes += staticTableMDDs[action][prec]->numberOfNodes;
+				}
+			}
 		}
 
 		deletedTuples[action].resize(task.actions[action].get_effects().size());
@@ -678,6 +752,79 @@ LiftedSAT::LiftedSAT(const Task & task) {
 			}
 		}
 	}
+	cout << "- " << compiledTables << " of " << staticTables << " static tables encoded as MDDs with " << compiledNodes << " nodes" << endl;
+}
+
+
+// builds the node for the tuples [begin,end) (sorted, all with the same prefix) in the given layer
+// and returns its number, nodes with the same edges are merged via the unique table of the layer
+static int buildMDDNode(StaticTableMDD* mdd, vector<map<map<int,int>,int>> & unique,
+		const vector<vector<int>> & tuples, size_t begin, size_t end, size_t layer){
+	map<int,int> edges;
+	for (size_t i = begin; i < end; ){
+		size_t j = i;
+		while (j < end && tuples[j][layer] == tuples[i][layer]) j++;
+		edges[tuples[i][layer]] = (layer + 1 == mdd->layerParameter.size()) ? -1 : buildMDDNode(mdd,unique,tuples,i,j,layer+1);
+		i = j;
+	}
+
+	auto it = unique[layer].find(edges);
+	if (it != unique[layer].end()) return it->second;
+	int node = mdd->edges[layer].size();
+	unique[layer][edges] = node;
+	mdd->edges[layer].push_back(edges);
+	mdd->numberOfNodes++;
+	return node;
+}
+
+StaticTableMDD* LiftedSAT::compileStaticTable(int action, const Atom & prec, const vector<pair<vector<int>,int>> & tuples){
+	StaticTableMDD* mdd = new StaticTableMDD();
+	vector<int> layerArgument;
+	for (size_t j = 0; j < prec.arguments.size(); j++)
+		if (!prec.arguments[j].constant){
+			layerArgument.push_back(j);
+			mdd->layerParameter.push_back(actionArgumentPositions[action][prec.arguments[j].index]);
+		}
+
+	// project the tuples onto the layers, sorted such that tuples with the same prefix are adjacent
+	vector<vector<int>> projected;
+	for (const auto & tuple : tuples){
+		vector<int> values;
+		for (int j : layerArgument)
+			values.push_back(objToIndex[tuple.first[j]]);
+		projected.push_back(values);
+	}
+	sort(projected.begin(), projected.end());
+	projected.erase(unique(projected.begin(), projected.end()), projected.end());
+
+	size_t layers = mdd->layerParameter.size();
+	mdd->edges.resize(layers);
+	vector<map<map<int,int>,int>> uniqueNodes(layers);
+	buildMDDNode(mdd,uniqueNodes,projected,0,projected.size(),0);
+	assert(mdd->edges[0].size() == 1);
+
+	// the MDD only pays off if suffixes are shared, compare the literals of both encodings per step
+	// prefix encoding: for every prefix, its action and values imply one of the next values
+	long prefixLiterals = 0;
+	for (size_t l = 0; l < layers; l++){
+		for (size_t i = 0; i < projected.size(); i++){
+			bool newPrefix = (i == 0) || !equal(projected[i].begin(), projected[i].begin() + l, projected[i-1].begin());
+			bool newValue = newPrefix || projected[i][l] != projected[i-1][l];
+			if (newPrefix) prefixLiterals += 1 + l;
+			if (newValue) prefixLiterals++;
+		}
+	}
+	// MDD: every node implies one of its values, every inner edge is a ternary clause
+	long mddLiterals = 0;
+	for (size_t l = 0; l < layers; l++)
+		for (auto & nodeEdges : mdd->edges[l])
+			mddLiterals += 1 + nodeEdges.size() + ((l + 1 < layers) ? 3 * nodeEdges.size() : 0);
+
+	if (mddLiterals >= prefixLiterals){
+		delete mdd;
+		return nullptr;
+	}
+	return mdd;
 }
 
 
@@ -701,6 +848,43 @@ void printVariableTruth(void* solver, sat_capsule & capsule){
 	}
 }
 
+// Two action schemas interfere if one of them might achieve or destroy a precondition of the
+// other, or if one of them adds an atom the other one deletes. Otherwise, two adjacent
+// instances of them can be swapped without changing applicability or the resulting state.
+void LiftedSAT::computeInterference(const Task & task){
+	interferes.assign(task.actions.size(), vector<bool>(task.actions.size(), false));
+	for (size_t action = 0; action < task.actions.size(); action++){
+		for (ActionPrecAchiever* precAchiever : achievers[action]->precAchievers){
+			for (Achiever* achiever : precAchiever->achievers)
+				interferes[action][achiever->action] = interferes[achiever->action][action] = true;
+			for (Achiever* destroyer : precAchiever->destroyers)
+				interferes[action][destroyer->action] = interferes[destroyer->action][action] = true;
+		}
+
+		for (size_t other = 0; other < task.actions.size(); other++){
+			// nullary atoms: the achiever tables do not contain deleters of nullary preconditions
+			for (int n : *setPosNullaryEff[other])
+				if (setPosNullaryPrec[action]->count(n) || setNegNullaryPrec[action]->count(n) || setNegNullaryEff[action]->count(n))
+					interferes[action][other] = interferes[other][action] = true;
+			for (int n : *setNegNullaryEff[other])
+				if (setPosNullaryPrec[action]->count(n) || setNegNullaryPrec[action]->count(n))
+					interferes[action][other] = interferes[other][action] = true;
+
+			for (const auto & eff : task.actions[action].get_effects())
+				for (const auto & otherEff : task.actions[other].get_effects())
+					if (eff.predicate_symbol == otherEff.predicate_symbol && eff.negated != otherEff.negated)
+						interferes[action][other] = interferes[other][action] = true;
+		}
+	}
+
+	int independent = 0;
+	for (size_t a = 0; a < task.actions.size(); a++)
+		for (size_t b = a + 1; b < task.actions.size(); b++)
+			if (!interferes[a][b]) independent++;
+	cout << "- " << independent << " pairs of independent action schemas" << endl;
+}
+
+
 bool LiftedSAT::atom_not_satisfied(const DBState &s,
                                    const AtomicGoal &atomicGoal) const {
     const auto &tuples = s.get_relations()[atomicGoal.predicate].tuples;
@@ -711,7 +895,13 @@ bool LiftedSAT::atom_not_satisfied(const DBState &s,
 
 
 vector<vector<int>> goalSupporterVars;
+// noGoalSupportAfter[k] excludes goal support after time step k-1, it implies noGoalSupportAfter[k+1]
+std::vector<int> noGoalSupportAfter;
+// activation literal of the goal for each horizon, assumed when solving for that horizon
+std::map<int,int> goalActivation;
 std::vector<std::vector<std::vector<int>>> parameterVars;
+// bits of the log-encoded argument positions, empty for one-hot positions
+std::vector<std::vector<std::vector<int>>> parameterBits;
 std::vector<std::vector<int>> actionVars;
 std::unordered_map<int,int> lastNullary;
 std::vector<std::vector<int>> initNotTrueAfter;
@@ -737,8 +927,104 @@ int noDeleter = 0;
 int oneAction = 0; 
 int goalAchiever = 0; 
 int goalDeleter = 0; 
+int stepOrder = 0;
 
 
+// Chain of variables excluding goal support after a time step, one for every goal supporter time
+void generateNoGoalSupportAfter(void* solver, sat_capsule & capsule){
+	size_t times = 0;
+	for (auto & goalSupporter : goalSupporterVars)
+		times = max(times, goalSupporter.size());
+
+	for (size_t k = 0; k < times; k++){
+		int afterVar = capsule.new_variable();
+		DEBUG(capsule.registerVariable(afterVar, "noGoalSupportAfter#" + to_string(int(k)-1)));
+		noGoalSupportAfter.push_back(afterVar);
+	}
+	for (size_t k = 0; k < times; k++){
+		if (k + 1 < times)
+			implies(solver,noGoalSupportAfter[k],noGoalSupportAfter[k+1]);
+		for (auto & goalSupporter : goalSupporterVars)
+			if (k + 1 < goalSupporter.size())
+				impliesNot(solver,noGoalSupportAfter[k],goalSupporter[k+1]);
+	}
+}
+
+// Variable stating that argument position param has the o-th object of its type at time.
+// For log-encoded positions, it is created when first needed and defined by the bits of o.
+int parameterValue(void* solver, sat_capsule & capsule, int time, int param, int o){
+	int & valueVar = parameterVars[time][param][o];
+	if (valueVar) return valueVar;
+
+	valueVar = capsule.new_variable();
+	DEBUG(capsule.registerVariable(valueVar, "const@" + to_string(time) + "#" + to_string(param) + "-" + to_string(o)));
+	const std::vector<int> & bits = parameterBits[time][param];
+	std::set<int> pattern;
+	for (size_t b = 0; b < bits.size(); b++){
+		int bitLiteral = (o & (1 << b)) ? bits[b] : -bits[b];
+		implies(solver,valueVar,bitLiteral);
+		pattern.insert(bitLiteral);
+	}
+	andImplies(solver,pattern,valueVar);
+	return valueVar;
+}
+
+
+
+// Encodes that if the action is chosen, its arguments form a path through the MDD of a static table.
+// The action itself takes the role of the root, the node variables of the other layers are fresh in
+// every step. A node implies one of the values on its edges, a node and a value imply the successor.
+// The support clauses only strengthen propagation: a node implies one of its parents, and if the
+// action is chosen, a value of a layer implies one of the nodes of the layer with an edge for it.
+void LiftedSAT::encodeStaticTable(void* solver, sat_capsule & capsule, StaticTableMDD* mdd, int time, int action, int actionVar){
+	size_t layers = mdd->layerParameter.size();
+	vector<vector<int>> nodeVars(layers);
+	nodeVars[0].push_back(actionVar);
+	for (size_t l = 1; l < layers; l++)
+		for (size_t n = 0; n < mdd->edges[l].size(); n++){
+			int nodeVar = capsule.new_variable();
+			nodeVars[l].push_back(nodeVar);
+			DEBUG(capsule.registerVariable(nodeVar, "mdd@" + to_string(time) + "#" + to_string(action) + "-" + to_string(l) + "-" + to_string(n)));
+		}
+
+	for (size_t l = 0; l < layers; l++){
+		int myParam = mdd->layerParameter[l];
+		int lower = lowerTindex[typeOfArgument[myParam]];
+		for (size_t n = 0; n < mdd->edges[l].size(); n++){
+			vector<int> values;
+			for (auto & edge : mdd->edges[l][n]){
+				int valueVar = parameterValue(solver,capsule,time,myParam,edge.first - lower);
+				values.push_back(valueVar);
+				if (l + 1 < layers)
+					andImplies(solver,nodeVars[l][n],valueVar,nodeVars[l+1][edge.second]);
+			}
+			impliesOr(solver,nodeVars[l][n],values);
+		}
+	}
+
+	for (size_t l = 1; l < layers; l++){
+		int myParam = mdd->layerParameter[l];
+		int lower = lowerTindex[typeOfArgument[myParam]];
+		vector<vector<int>> parents(mdd->edges[l].size());
+		for (size_t n = 0; n < mdd->edges[l-1].size(); n++)
+			for (auto & edge : mdd->edges[l-1][n])
+				parents[edge.second].push_back(nodeVars[l-1][n]);
+		for (size_t n = 0; n < mdd->edges[l].size(); n++){
+			sort(parents[n].begin(), parents[n].end());
+			parents[n].erase(unique(parents[n].begin(), parents[n].end()), parents[n].end());
+			impliesOr(solver,nodeVars[l][n],parents[n]);
+		}
+
+		map<int,vector<int>> nodesWithValue;
+		for (size_t n = 0; n < mdd->edges[l].size(); n++)
+			for (auto & edge : mdd->edges[l][n])
+				nodesWithValue[edge.first].push_back(nodeVars[l][n]);
+		for (auto & entry : nodesWithValue){
+			int valueVar = parameterValue(solver,capsule,time,myParam,entry.first - lower);
+			impliesOr(solver,actionVar,valueVar,entry.second);
+		}
+	}
+}
 
 // Generator function for the formula.
 // This function generates *one* time step of the formula
@@ -885,6 +1171,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 			variableInitMaintenance += get_number_of_clauses() - bef;
 
 			std::vector<std::vector<int>> parameterVarsTime(numberOfArgumentPositions);
+			std::vector<std::vector<int>> parameterBitsTime(numberOfArgumentPositions);
     		for (int paramter = 0; paramter < numberOfArgumentPositions; paramter++){
 				int type = typeOfArgument[paramter];
 				int lower = lowerTindex[type];
@@ -892,6 +1179,18 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 				
 				parameterVarsTime[paramter].resize(upper - lower + 1);
 
+				if (logEncodingThreshold > 0 && upper - lower + 1 > logEncodingThreshold){
+					// log encoding: the value is the binary number of the bits, its variables are created on demand
+					for (int b = 0; (1 << b) < upper - lower + 1; b++){
+						int bitVar = capsule.new_variable();
+						parameterBitsTime[paramter].push_back(bitVar);
+						DEBUG(capsule.registerVariable(bitVar, "bit@" + to_string(time) + "#" + to_string(paramter) + "-" + to_string(b)));
+					}
+					// the value must be one of the objects of the type
+					atMostValue(solver,parameterBitsTime[paramter],upper - lower);
+					continue;
+				}
+
 				for (int o = 0; o < upper - lower + 1; o++){
 					int objectVar = capsule.new_variable();
 					parameterVarsTime[paramter][o] = objectVar;
@@ -901,6 +1200,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 				atMostOne(solver,capsule,parameterVarsTime[paramter]);
 			}
 			parameterVars.push_back(parameterVarsTime);
+			parameterBits.push_back(parameterBitsTime);
 
 			atMostOneParamterValue += get_number_of_clauses() - bef;
 			bef = get_number_of_clauses();
@@ -979,19 +1279,22 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 					if (equalsPairs[{paramterThis,paramterBefore}].size() == 1){
 						DEBUG(cout << " always true" << endl); 
 						assertYes(solver,equalsVar);
+					} else if (sameLogEncoding(paramterThis,paramterBefore)){
+						DEBUG(cout << " bitwise" << endl); 
+						equalBits(solver,capsule,equalsVar,parameterBits[time][paramterThis],parameterBits[pTime][paramterBefore]);
 					} else {
 						int thisLower = lowerTindex[typeOfArgument[paramterThis]];
 						int beforeLower = lowerTindex[typeOfArgument[paramterBefore]];
 						for(int o : equalsPairs[{paramterThis,paramterBefore}]){
 							if (o < lowerTindex[typeOfArgument[paramterThis]] || o > upperTindex[typeOfArgument[paramterThis]]){
-								impliesNot(solver,equalsVar, parameterVars[pTime][paramterBefore][o-beforeLower]);
+								impliesNot(solver,equalsVar, parameterValue(solver,capsule,pTime,paramterBefore,o-beforeLower));
 							} else if (o < lowerTindex[typeOfArgument[paramterBefore]] || o > upperTindex[typeOfArgument[paramterBefore]]){
-								impliesNot(solver,equalsVar, parameterVars[time][paramterThis][o-thisLower]);
+								impliesNot(solver,equalsVar, parameterValue(solver,capsule,time,paramterThis,o-thisLower));
 							} else {
 								// need to subtract the starting values of the types
-								andImplies(solver,equalsVar, parameterVars[time][paramterThis][o-thisLower], parameterVars[pTime][paramterBefore][o-beforeLower]);
-								andImplies(solver,equalsVar, parameterVars[pTime][paramterBefore][o-beforeLower], parameterVars[time][paramterThis][o-thisLower]);
-								andImplies(solver,parameterVars[pTime][paramterBefore][o-beforeLower], parameterVars[time][paramterThis][o-thisLower], equalsVar);
+								andImplies(solver,equalsVar, parameterValue(solver,capsule,time,paramterThis,o-thisLower), parameterValue(solver,capsule,pTime,paramterBefore,o-beforeLower));
+								andImplies(solver,equalsVar, parameterValue(solver,capsule,pTime,paramterBefore,o-beforeLower), parameterValue(solver,capsule,time,paramterThis,o-thisLower));
+								andImplies(solver,parameterValue(solver,capsule,pTime,paramterBefore,o-beforeLower), parameterValue(solver,capsule,time,paramterThis,o-thisLower), equalsVar);
 							}
 						}
 #ifndef NDEBUG
@@ -1073,9 +1376,12 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 					//	impliesNot(solver,actionVar,parameterConstantVar);
 					//}
 
+					// the bits of log-encoded positions always denote an object of the type
+					if (parameterBits[time][thisParameterIndex].size()) continue;
+
 					std::vector<int> allowed;
 					for (int i = 0; i <= upper - lower; i++){
-						int parameterConstantVar = parameterVars[time][thisParameterIndex][i];
+						int parameterConstantVar = parameterValue(solver,capsule,time,thisParameterIndex,i);
 						allowed.push_back(parameterConstantVar);
 					}
 					impliesOr(solver,actionVar,allowed);
@@ -1132,18 +1438,24 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 							if (precObjec.arguments[0].constant){
 								int myObjIndex = objToIndex[varA];
 								varB = actionArgumentPositions[action][varB];
-								impliesNot(solver,actionVar, parameterVars[time][varB][myObjIndex - lowerTindex[typeOfArgument[varB]]]);
+								impliesNot(solver,actionVar, parameterValue(solver,capsule,time,varB,myObjIndex - lowerTindex[typeOfArgument[varB]]));
 							} else if (precObjec.arguments[1].constant){
 								int myObjIndex = objToIndex[varB];
 								varA = actionArgumentPositions[action][varA];
-								impliesNot(solver,actionVar, parameterVars[time][varA][myObjIndex - lowerTindex[typeOfArgument[varA]]]);
+								impliesNot(solver,actionVar, parameterValue(solver,capsule,time,varA,myObjIndex - lowerTindex[typeOfArgument[varA]]));
 							} else {
 								varA = actionArgumentPositions[action][varA];
 								varB = actionArgumentPositions[action][varB];
-								for(int o = max(lowerTindex[typeOfArgument[varA]],lowerTindex[typeOfArgument[varB]]);
-										o <= min(upperTindex[typeOfArgument[varA]],upperTindex[typeOfArgument[varB]]); o++){
-									andImpliesNot(solver,actionVar,parameterVars[time][varA][o - lowerTindex[typeOfArgument[varA]]],
-											parameterVars[time][varB][o - lowerTindex[typeOfArgument[varB]]]);
+								if (sameLogEncoding(varA,varB)){
+									int equalsVar = capsule.new_variable();
+									equalBits(solver,capsule,equalsVar,parameterBits[time][varA],parameterBits[time][varB]);
+									impliesNot(solver,actionVar,equalsVar);
+								} else {
+									for(int o = max(lowerTindex[typeOfArgument[varA]],lowerTindex[typeOfArgument[varB]]);
+											o <= min(upperTindex[typeOfArgument[varA]],upperTindex[typeOfArgument[varB]]); o++){
+										andImpliesNot(solver,actionVar,parameterValue(solver,capsule,time,varA,o - lowerTindex[typeOfArgument[varA]]),
+												parameterValue(solver,capsule,time,varB,o - lowerTindex[typeOfArgument[varB]]));
+									}
 								}
 							}
 						} else {
@@ -1151,20 +1463,26 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 							if (precObjec.arguments[0].constant){
 								int myObjIndex = objToIndex[varA];
 								varB = actionArgumentPositions[action][varB];
-								implies(solver,actionVar, parameterVars[time][varB][myObjIndex - lowerTindex[typeOfArgument[varB]]]);
+								implies(solver,actionVar, parameterValue(solver,capsule,time,varB,myObjIndex - lowerTindex[typeOfArgument[varB]]));
 							} else if (precObjec.arguments[1].constant){
 								int myObjIndex = objToIndex[varB];
 								varA = actionArgumentPositions[action][varA];
-								implies(solver,actionVar, parameterVars[time][varA][myObjIndex - lowerTindex[typeOfArgument[varA]]]);
+								implies(solver,actionVar, parameterValue(solver,capsule,time,varA,myObjIndex - lowerTindex[typeOfArgument[varA]]));
 							} else {
 								varA = actionArgumentPositions[action][varA];
 								varB = actionArgumentPositions[action][varB];
-								for(int o = max(lowerTindex[typeOfArgument[varA]],lowerTindex[typeOfArgument[varB]]);
-										o <= min(upperTindex[typeOfArgument[varA]],upperTindex[typeOfArgument[varB]]); o++){
-									andImplies(solver,actionVar,parameterVars[time][varA][o - lowerTindex[typeOfArgument[varA]]],
-											parameterVars[time][varB][o - lowerTindex[typeOfArgument[varB]]]);
-									andImplies(solver,actionVar,parameterVars[time][varB][o - lowerTindex[typeOfArgument[varB]]],
-											parameterVars[time][varA][o - lowerTindex[typeOfArgument[varA]]]);
+								if (sameLogEncoding(varA,varB)){
+									int equalsVar = capsule.new_variable();
+									equalBits(solver,capsule,equalsVar,parameterBits[time][varA],parameterBits[time][varB]);
+									implies(solver,actionVar,equalsVar);
+								} else {
+									for(int o = max(lowerTindex[typeOfArgument[varA]],lowerTindex[typeOfArgument[varB]]);
+											o <= min(upperTindex[typeOfArgument[varA]],upperTindex[typeOfArgument[varB]]); o++){
+										andImplies(solver,actionVar,parameterValue(solver,capsule,time,varA,o - lowerTindex[typeOfArgument[varA]]),
+												parameterValue(solver,capsule,time,varB,o - lowerTindex[typeOfArgument[varB]]));
+										andImplies(solver,actionVar,parameterValue(solver,capsule,time,varB,o - lowerTindex[typeOfArgument[varB]]),
+												parameterValue(solver,capsule,time,varA,o - lowerTindex[typeOfArgument[varA]]));
+									}
 								}
 							}
 						}
@@ -1210,9 +1528,9 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 											impliesNot(solver,actionVar,precSupporter[time][prec][0]);
 									} else {
 										if (task.predicates[predicate].isStaticPredicate())
-											implies(solver,actionVar, parameterVars[time][myParam][myObjIndex - lowerTindex[typeOfArgument[myParam]]]);
+											implies(solver,actionVar, parameterValue(solver,capsule,time,myParam,myObjIndex - lowerTindex[typeOfArgument[myParam]]));
 										else
-											impliesAnd(solver,actionVar,precSupporter[time][prec][0], parameterVars[time][myParam][myObjIndex - lowerTindex[typeOfArgument[myParam]]]);
+											impliesAnd(solver,actionVar,precSupporter[time][prec][0], parameterValue(solver,capsule,time,myParam,myObjIndex - lowerTindex[typeOfArgument[myParam]]));
 									}
 								}
 							}
@@ -1225,7 +1543,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 								
 									int myObjIndex = objToIndex[tuple[0]];
 									int myParam = actionArgumentPositions[action][precObjec.arguments[0].index];
-									int constantVar = parameterVars[time][myParam][myObjIndex - lowerTindex[typeOfArgument[myParam]]];
+									int constantVar = parameterValue(solver,capsule,time,myParam,myObjIndex - lowerTindex[typeOfArgument[myParam]]);
 									
 									possibleValues.push_back(constantVar);
 								}
@@ -1234,6 +1552,8 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 									impliesOr(solver,actionVar,possibleValues);
 								else
 									impliesOr(solver,actionVar,precSupporter[time][prec][0],possibleValues);
+							} else if (staticTableMDDs[action][prec]){
+								encodeStaticTable(solver,capsule,staticTableMDDs[action][prec],time,action,actionVar);
 							} else {
 								bool firstWithNonConst = true;
 								for (size_t lastPos = 0; lastPos < precObjec.arguments.size() - 1 ; lastPos++){
@@ -1255,7 +1575,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 											if (precObjec.arguments[j].constant) continue;
 											int myObjIndex = objToIndex[tuple[j]];
 											int myParam = actionArgumentPositions[action][precObjec.arguments[j].index];
-											int constantVar = parameterVars[time][myParam][myObjIndex - lowerTindex[typeOfArgument[myParam]]];
+											int constantVar = parameterValue(solver,capsule,time,myParam,myObjIndex - lowerTindex[typeOfArgument[myParam]]);
 											
 											subTuple.push_back(constantVar);
 										}
@@ -1269,7 +1589,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 										int myParam = actionArgumentPositions[action][precObjec.arguments[lastPos + 1].index];
 										int localObjectNumber = myObjIndex - lowerTindex[typeOfArgument[myParam]];
 										//if (localObjectNumber >= parameterVars[time][myParam].size()) cout << "F " << localObjectNumber << " " << parameterVars[time][myParam].size() << endl;
-										int constantVar = parameterVars[time][myParam][localObjectNumber];
+										int constantVar = parameterValue(solver,capsule,time,myParam,localObjectNumber);
 
 
 										possibleUpto[subTuple].insert(constantVar);
@@ -1324,7 +1644,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 									if (!precObjec.arguments[j].constant){
 										int myParam = actionArgumentPositions[action][precObjec.arguments[j].index];
 										if (!(myObjIndex < lowerTindex[typeOfArgument[myParam]] || myObjIndex > upperTindex[typeOfArgument[myParam]]))
-											criticalVars.insert(parameterVars[time][myParam][myObjIndex - lowerTindex[typeOfArgument[myParam]]]);
+											criticalVars.insert(parameterValue(solver,capsule,time,myParam,myObjIndex - lowerTindex[typeOfArgument[myParam]]));
 									}
 								}
 								// now they can't all be true *and* we have deleted the init
@@ -1390,9 +1710,9 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 									if (theirParam < 0){
 										int theirConst  = -theirParam-1;
 										if (!allDifferentActions)
-											implies(solver,achieverVar,parameterVars[time][myParam][objToIndex[theirConst] - lowerTindex[typeOfArgument[myParam]]]);
+											implies(solver,achieverVar,parameterValue(solver,capsule,time,myParam,objToIndex[theirConst] - lowerTindex[typeOfArgument[myParam]]));
 										else
-											andImplies(solver,actionVar,precSupporter[time][prec][i],achieverVar,parameterVars[time][myParam][objToIndex[theirConst] - lowerTindex[typeOfArgument[myParam]]]);
+											andImplies(solver,actionVar,precSupporter[time][prec][i],achieverVar,parameterValue(solver,capsule,time,myParam,objToIndex[theirConst] - lowerTindex[typeOfArgument[myParam]]));
 									} else {
 										int myType = task.actions[action].get_parameters()[precObjec.arguments[k].index].type;
 										int theirType = task.actions[achiever->action].get_parameters()[theirParam].type; 
@@ -1419,9 +1739,9 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 										theirParam = actionArgumentPositions[achiever->action][theirParam];
 
 										if (!allDifferentActions)
-											implies(solver,achieverVar,parameterVars[i-1][theirParam][objToIndex[myConst] - lowerTindex[typeOfArgument[theirParam]]]);
+											implies(solver,achieverVar,parameterValue(solver,capsule,i-1,theirParam,objToIndex[myConst] - lowerTindex[typeOfArgument[theirParam]]));
 										else
-											andImplies(solver,actionVar,precSupporter[time][prec][i],achieverVar,parameterVars[i-1][theirParam][objToIndex[myConst] - lowerTindex[typeOfArgument[theirParam]]]);
+											andImplies(solver,actionVar,precSupporter[time][prec][i],achieverVar,parameterValue(solver,capsule,i-1,theirParam,objToIndex[myConst] - lowerTindex[typeOfArgument[theirParam]]));
 									
 									} // else two constants, this has been checked statically
 								}
@@ -1447,6 +1767,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 			
 						for (size_t k = 0; k < deleter->params.size(); k++){
 							int deleterParam = deleter->params[k];
+							if (deleterParam == ANY_PARAMETER) continue; // position not constrained by a mutex destroyer
 							
 							if (!precObjec.arguments[k].constant){
 								int myParam = precObjec.arguments[k].index; // my index position
@@ -1469,7 +1790,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 									// deleter is a constant
 									int deleterConst  = -deleterParam-1;
 									myParam = actionArgumentPositions[action][myParam];
-									criticalVars.push_back(parameterVars[time][myParam][objToIndex[deleterConst] - lowerTindex[typeOfArgument[myParam]]]);
+									criticalVars.push_back(parameterValue(solver,capsule,time,myParam,objToIndex[deleterConst] - lowerTindex[typeOfArgument[myParam]]));
 								}
 							} else {
 								int myConst = precObjec.arguments[k].index; // my index position
@@ -1477,7 +1798,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 								// deleter is a variable
 								if (deleterParam >= 0){
 									deleterParam = actionArgumentPositions[deleter->action][deleterParam];
-									criticalVars.push_back(parameterVars[deleterTime][deleterParam][objToIndex[myConst] - lowerTindex[typeOfArgument[deleterParam]]]);
+									criticalVars.push_back(parameterValue(solver,capsule,deleterTime,deleterParam,objToIndex[myConst] - lowerTindex[typeOfArgument[deleterParam]]));
 								} else if (myConst != -deleterParam-1)
 									noNeed = true;
 								//else equals no nothing to assert
@@ -1519,7 +1840,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 							if (!eff.arguments[j].constant){
 								int myParam = actionArgumentPositions[action][eff.arguments[j].index];
 								if (!(myObjIndex < lowerTindex[typeOfArgument[myParam]] || myObjIndex > upperTindex[typeOfArgument[myParam]]))
-									neededVariables.insert(parameterVars[time][myParam][myObjIndex - lowerTindex[typeOfArgument[myParam]]]);
+									neededVariables.insert(parameterValue(solver,capsule,time,myParam,myObjIndex - lowerTindex[typeOfArgument[myParam]]));
 							}
 						}
 						andImplies(solver,neededVariables,initNotTrueAfter[time][deletedTuples[action][ie][i].second]);
@@ -1553,10 +1874,25 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 			for (int thisAction : actionVarsTime)
 				impliesOr(solver,thisAction,actionVars.back());
 		}
+		oneAction += get_number_of_clauses() - bef;
+		bef = get_number_of_clauses();
+
+		// slot is the position of this time step in its step. Independent actions in the same
+		// step are ordered by their index, all other orders are equivalent
+		int slot = time % stepSlots;
+		if (slot && generateBaseFormula){
+			for (size_t before = 0; before < task.actions.size(); before++)
+				for (size_t after = 0; after < before; after++)
+					if (!interferes[before][after])
+						impliesNot(solver,actionVars.back()[before],actionVarsTime[after]);
+		}
+		stepOrder += get_number_of_clauses() - bef;
+		bef = get_number_of_clauses();
 
 		if (generateBaseFormula){
 			actionVars.push_back(actionVarsTime);
-			if (forceActionEveryStep) atLeastOne(solver,capsule,actionVarsTime); // correct for incremental solving
+			// with several slots per step, only the first slot of a step must contain an action
+			if (forceActionEveryStep && !slot) atLeastOne(solver,capsule,actionVarsTime); // correct for incremental solving
 			//atLeastOne(solver,capsule,actionVarsTime); // correct for incremental solving
 			atMostOne(solver,capsule,actionVarsTime);
 		}
@@ -1568,22 +1904,26 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 
 
 	bef = get_number_of_clauses();
-	// nullary goal
-	int nullaryGoalBlocker = capsule.new_variable();
-	DEBUG(capsule.registerVariable(nullaryGoalBlocker,"nullaryGoalBlocker#" + to_string(planLength)));
-	
-	if (generateBaseFormula){
-		if (!onlyGenerate) {
-			if (onlyHardConstraints)
-				assertYes(solver,nullaryGoalBlocker);
-			else
-				ipasir_assume(solver,nullaryGoalBlocker);
-		}
+	// The goal of this horizon is guarded by an activation literal. It requires the nullary goals and
+	// excludes goal support after the horizon. In incremental mode, it is assumed instead of asserted,
+	// such that the formula can be extended to later horizons.
+	if (!onlyGenerate && !goalActivation.count(planLength)){
+		int activationVar = capsule.new_variable();
+		DEBUG(capsule.registerVariable(activationVar,"goalActivation#" + to_string(planLength)));
+		goalActivation[planLength] = activationVar;
 		
 	    for (int g : task.goal.positive_nullary_goals)
-			implies(solver,nullaryGoalBlocker,lastNullary[g]);	
+			implies(solver,activationVar,lastNullary[g]);	
 	    for (int g : task.goal.negative_nullary_goals)
-			impliesNot(solver,nullaryGoalBlocker,lastNullary[g]);	
+			impliesNot(solver,activationVar,lastNullary[g]);	
+		if (planLength < int(noGoalSupportAfter.size()))
+			implies(solver,activationVar,noGoalSupportAfter[planLength]);
+	}
+	if (!onlyGenerate) {
+		if (onlyHardConstraints)
+			assertYes(solver,goalActivation[planLength]);
+		else
+			ipasir_assume(solver,goalActivation[planLength]);
 	}
 	nullary += get_number_of_clauses() - bef;
 	bef = get_number_of_clauses();
@@ -1632,23 +1972,13 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 								if (constIdx < lower || constIdx > upper)
 									assertNot(solver, achieverVar);
 								else
-									implies(solver,achieverVar, parameterVars[pTime][theirParam][constIdx - lower]);
+									implies(solver,achieverVar, parameterValue(solver,capsule,pTime,theirParam,constIdx - lower));
 							} // else it is a constant and has already been checked
 						}
 					}
 				}
 				impliesOr(solver,goalSuppVar,achieverSelection);
 			}
-		
-			// don't use later support ... These assumptions are cleared after each call
-			
-			if (!onlyGenerate){
-				for (size_t time = planLength + 1; time < goalSupporterVars[goal].size(); time++)
-					if (onlyHardConstraints)
-						assertNot(solver,goalSupporterVars[goal][time]);
-					else
-						ipasir_assume(solver,-goalSupporterVars[goal][time]);
-			}
 		}
 	}
 	goalAchiever += get_number_of_clauses() - bef;
@@ -1684,7 +2014,7 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 						int theirParam = actionArgumentPositions[destroyer->action][destroyer->params[k]];
 
 						if (theirParam >= 0){
-							criticalVars.push_back(parameterVars[planLength-1][theirParam][objToIndex[myConst] - lowerTindex[typeOfArgument[theirParam]]]);
+							criticalVars.push_back(parameterValue(solver,capsule,planLength-1,theirParam,objToIndex[myConst] - lowerTindex[typeOfArgument[theirParam]]));
 						} // else it is a constant and has already been checked
 					}
 
@@ -1716,6 +2046,8 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 	cout << "\tgoal achievers     " << setw(9) << goalAchiever << endl; 
 	cout << "\tgoal deleters      " << setw(9) << goalDeleter << endl; 
 	cout << "\tnullary            " << setw(9) << nullary << endl;
+	if (stepSlots > 1)
+		cout << "\tstep order         " << setw(9) << stepOrder << endl;
 
 		
 	DEBUG(capsule.printVariables());
@@ -1748,7 +2080,8 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 	// extract the plan
 	vector<LiftedOperatorId> plan;
 	for (int time = 0; time < planLength; time++){
-		cout << "timestep " << time << endl;
+		if (time % stepSlots == 0)
+			cout << "timestep " << time / stepSlots << endl;
 		for (size_t action = 0; action < task.actions.size(); action++){
 			int var = actionVars[time][action];
 			if (ipasir_val(solver,var) > 0){
@@ -1759,6 +2092,15 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
             	for (size_t l = 0; l < params.size(); l++) {
 					int p = actionArgumentPositions[action][l];
 					cout << " " << l << ":";
+					if (parameterBits[time][p].size()){
+						int o = 0;
+						for (size_t b = 0; b < parameterBits[time][p].size(); b++)
+							if (ipasir_val(solver,parameterBits[time][p][b]) > 0)
+								o |= 1 << b;
+						cout << " " << task.objects[indexToObj[o + lowerTindex[typeOfArgument[p]]]].getName();
+						arguments.push_back(indexToObj[o + lowerTindex[typeOfArgument[p]]]);
+						continue;
+					}
 					for (int o = 0; o <= upperTindex[typeOfArgument[p]] - lowerTindex[typeOfArgument[p]]; o++){
 						if (ipasir_val(solver,parameterVars[time][p][o]) > 0){
 							cout << " " << task.objects[indexToObj[o + lowerTindex[typeOfArgument[p]]]].getName();
@@ -1782,21 +2124,40 @@ bool LiftedSAT::generate_formula(const Task &task, const std::clock_t & startTim
 
 
 
-utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool incremental) {
-    maxLen = limit;
+utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool incremental, int slots, utils::Budget &budget) {
+	if (slots < 1){
+		cerr << "The number of slots per step must be positive." << endl;
+		exit(-1);
+	}
+	// the plan length is given in steps, the formula is generated per slot
+	stepSlots = slots;
+    maxLen = limit * stepSlots;
+	if (stepSlots > 1)
+		computeInterference(task);
 	bool satisficing = !optimal;
 
+	auto init_solver = [&]() {
+		void* solver = ipasir_init();
+		ipasir_set_terminate(solver, &budget, utils::Budget::terminate_sat_solver);
+		return solver;
+	};
+	auto budget_exhausted = [&](void* solver) {
+		ipasir_release(solver);
+		budget.print_exhausted();
+		return budget.get_exit_code();
+	};
+
 	if (satisficing){
 		DEBUG(cout << "Parameter arity " << maxArity << " Objects " << task.objects.size() << endl);
 		// start the incremental search for a plan	
 		void* solver;
 		if (incremental)
-			solver = ipasir_init();
+			solver = init_solver();
 		sat_capsule capsule;
 		
 		for (int pastLimit = 1; pastLimit < maxLen + 1; pastLimit++){
 			if (!incremental) {// create a new solver instance for every ACD
-				solver = ipasir_init();
+				solver = init_solver();
 				capsule.number_of_variables = 0;
 				DEBUG(capsule.variableNames.clear());
 				reset_number_of_clauses();
@@ -1817,6 +2178,7 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 				oneAction = 0; 
 				goalAchiever = 0; 
 				goalDeleter = 0; 
+				stepOrder = 0;
 			}
 
 			
@@ -1829,7 +2191,10 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 
 			if (!incremental){
 				goalSupporterVars.clear();
+				noGoalSupportAfter.clear();
+				goalActivation.clear();
 				parameterVars.clear();
+				parameterBits.clear();
 				initNotTrueAfter.clear();
 				actionVars.clear();
 				parameterEquality.clear();
@@ -1863,6 +2228,7 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 					atLeastOne(solver,capsule,goalSupporter);
 					goalSupporterVars.push_back(goalSupporter);
 				}
+				generateNoGoalSupportAfter(solver,capsule);
 
 				// we only test executable plans and if the goal is a dead end ...
 				//if (!gc) return 0;
@@ -1884,6 +2250,8 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 		
 			planLength = 0;
 			while (planLength < maxLen){
+				if (budget.is_exhausted())
+					return budget_exhausted(solver);
 				planLength++;
 				generate_formula(task,start,solver,capsule,true,false,!incremental,incremental,pastLimit);
 			}
@@ -1896,13 +2264,8 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 			} else {
 				cout << "\t\tNo plan of length: " << planLength << endl;
 				DEBUG(cout << "\t\tNo plan of length: " << planLength << endl);
-				std::clock_t end = std::clock();
-				double time_in_ms = 1000.0 * (end-start) / CLOCKS_PER_SEC;
-				//cout << "Total time: " << fixed << time_in_ms << "ms" << endl;
-				if (time_in_ms > 300000000){
-					ipasir_release(solver);
-					return utils::ExitCode::SEARCH_OUT_OF_TIME;
-				}
+				if (budget.is_exhausted())
+					return budget_exhausted(solver);
 			}
 			if (!incremental)
 				ipasir_release(solver);
@@ -1911,13 +2274,13 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 		void* solver;
 		sat_capsule capsule;
 		if (incremental){
-			solver = ipasir_init();
+			solver = init_solver();
 			planLength = 0;
 		}
 		
-		for (int i = 0; i < maxLen; i++){
+		for (int i = 0; i < maxLen; i += stepSlots){
 			if (!incremental) {// create a new solver instance for every ACD
-				solver = ipasir_init();
+				solver = init_solver();
 				capsule.number_of_variables = 0;
 				DEBUG(capsule.variableNames.clear());
 				reset_number_of_clauses();
@@ -1938,6 +2301,7 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 				oneAction = 0; 
 				goalAchiever = 0; 
 				goalDeleter = 0; 
+				stepOrder = 0;
 			}
 
 			std::clock_t start = std::clock();
@@ -1946,7 +2310,10 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 
 			if (!incremental){
 				goalSupporterVars.clear();
+				noGoalSupportAfter.clear();
+				goalActivation.clear();
 				parameterVars.clear();
+				parameterBits.clear();
 				actionVars.clear();
 				parameterEquality.clear();
 				precSupporter.clear();
@@ -1986,6 +2353,7 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 					atLeastOne(solver,capsule,goalSupporter);
 					goalSupporterVars.push_back(goalSupporter);
 				}
+				generateNoGoalSupportAfter(solver,capsule);
 				goalAchiever += get_number_of_clauses() - clausesBefore;
 				clausesBefore = get_number_of_clauses();
 
@@ -2022,7 +2390,9 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 					generate_formula(task,start,solver,capsule,true,false,false,false);
 				}
 			} else {
-				while (planLength < i){
+				while (planLength < i + stepSlots - 1){
+					if (budget.is_exhausted())
+						return budget_exhausted(solver);
 					planLength++;
 					generate_formula(task,start,solver,capsule,true,true,false,false);
 				}
@@ -2037,13 +2407,13 @@ utils::ExitCode LiftedSAT::solve(const Task &task, int limit, bool optimal, bool
 			} else {
 				cout << "\t\tNo plan of length: " << planLength << endl;
 				DEBUG(cout << "\t\tNo plan of length: " << planLength << endl);
-				std::clock_t end = std::clock();
-				double time_in_ms = 1000.0 * (end-start) / CLOCKS_PER_SEC;
-				//cout << "Total time: " << fixed << time_in_ms << "ms" << endl;
-				if (time_in_ms > 300000000){
+				if (budget.is_exhausted())
+					return budget_exhausted(solver);
+				// the goal cannot be reached at this horizon, its activation literal is no longer needed
+				if (incremental)
+					assertNot(solver,goalActivation[planLength]);
+				else
 					ipasir_release(solver);
-					return utils::ExitCode::SEARCH_OUT_OF_TIME;
-				}
 			}
 		}
 	}
@@ -2067,6 +2437,13 @@ int LiftedSAT::sortObjs(int index, int type) {
     return index;
 }
 
+bool LiftedSAT::sameLogEncoding(int paramA, int paramB){
+	int typeA = typeOfArgument[paramA];
+	int typeB = typeOfArgument[paramB];
+	return logEncodingThreshold > 0 && upperTindex[typeA] - lowerTindex[typeA] + 1 > logEncodingThreshold &&
+		lowerTindex[typeA] == lowerTindex[typeB] && upperTindex[typeA] == upperTindex[typeB];
+}
+
 int LiftedSAT::actionID(int i) {
     return (maxArity + 1) * i;
 }
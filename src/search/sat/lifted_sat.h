@@ -9,10 +9,15 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <ctime>
+#include <limits>
 #include "sat_encoder.h"
+#include "../utils/budget.h"
 #include "../utils/system.h"
 #include "../task.h"
 
+// parameter of a destroyer that does not constrain the corresponding argument of the precondition
+const int ANY_PARAMETER = std::numeric_limits<int>::min();
+
 struct Achiever {
     // the precondition "pred p0 p1 p3"
     // can be achieved using the following action
@@ -22,6 +27,7 @@ struct Achiever {
 	std::vector<int> params;
     // then, to achieve the predicate given above, the following must hold
     // v1 == p0, v3 == p1, v0 == p3
+    // destroyers derived from mutex groups use ANY_PARAMETER for the counted argument
 } ;
 
 struct ActionPrecAchiever {
@@ -38,6 +44,18 @@ struct ActionPrecAchievers {
     std::map<int, ActionPrecAchiever*> negNullaryPrecAchievers;
 };
 
+// Multi-valued decision diagram (MDD) of the tuples of a static relation that can support a precondition.
+// Layer l decides the l-th non-constant argument of the precondition, nodes with the same set of
+// suffixes are merged. It is built once and encoded with fresh node variables in every step, if that
+// is smaller than enumerating the prefixes of the tuples.
+struct StaticTableMDD {
+    // argument position of the encoding decided by each layer
+    std::vector<int> layerParameter;
+    // edges[l][n] maps an object (in objToIndex numbering) to a node of layer l+1, in the last layer to the terminal
+    std::vector<std::vector<std::map<int,int>>> edges;
+    int numberOfNodes = 0;
+};
+
 class LiftedSAT{
 private:
 	std::map<std::pair<int, int>, bool> needToType;
@@ -47,6 +65,13 @@ private:
     int maxPrec = -1;
 
 	int maxLen;
+
+	// number of action slots per step, slots of a step are ordered (relaxed exists-step semantics)
+	int stepSlots = 1;
+	// argument positions whose type has more objects than this are log-encoded (0: never)
+	int logEncodingThreshold = 0;
+	// interferes[a][b] is true if the order of action schemas a and b in a plan might matter
+	std::vector<std::vector<bool>> interferes;
     
 	int numObjs = -1;
     int numActions = -1;
@@ -77,10 +102,16 @@ private:
 	std::unordered_map<int,std::vector<int>> nullaryDestroyer;
 
     int sortObjs(int index, int type);
+    void computeInterference(const Task& task);
+    bool sameLogEncoding(int paramA, int paramB);
+    StaticTableMDD* compileStaticTable(int action, const Atom & prec, const std::vector<std::pair<std::vector<int>,int>> & tuples);
+    void encodeStaticTable(void* solver, sat_capsule & capsule, StaticTableMDD* mdd, int time, int action, int actionVar);
 public:
 
     LiftedSAT(const Task& task);
-	utils::ExitCode solve(const Task& task, int limit, bool optimal, bool incremental);
+	void setLogEncodingThreshold(int threshold) { logEncodingThreshold = threshold; }
+	// The budget is checked between the formulas and by the SAT solver (see ipasir_set_terminate)
+	utils::ExitCode solve(const Task& task, int limit, bool optimal, bool incremental, int slots, utils::Budget &budget);
 	bool generate_formula(const Task &task, const std::clock_t & start, void* solver, sat_capsule & capsule, bool onlyGenerate, bool forceActionEveryStep, bool onlyHardConstraints, bool pastIncremental, int pastLimit = 10000);
 	bool atom_not_satisfied(const DBState &s, const AtomicGoal &atomicGoal) const;
 
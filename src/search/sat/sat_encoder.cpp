@@ -202,6 +202,48 @@ void notAll(void* solver, std::set<int> i){
 	number_of_clauses++;
 }
 
+void atMostValue(void* solver, std::vector<int> & bits, int max){
+	// forbid every number that is larger than max in the first bit (from the top) where they differ
+	for (size_t i = 0; i < bits.size(); i++){
+		if (max & (1 << i)) continue;
+		ipasir_add(solver,-bits[i]);
+		for (size_t j = i+1; j < bits.size(); j++)
+			if (max & (1 << j))
+				ipasir_add(solver,-bits[j]);
+		ipasir_add(solver,0);
+		number_of_clauses++;
+	}
+}
+
+void equalBits(void* solver, sat_capsule & capsule, int e, std::vector<int> & a, std::vector<int> & b){
+	assert(a.size() == b.size());
+	std::vector<int> differs;
+	for (size_t i = 0; i < a.size(); i++){
+		// if equal, all bits are the same
+		andImplies(solver,e,a[i],b[i]);
+		andImplies(solver,e,b[i],a[i]);
+
+		// if not equal, one of the bits differs
+		int d = capsule.new_variable();
+		DEBUG(capsule.registerVariable(d,"differs " + pad_int(e) + " " + pad_int(i)));
+		ipasir_add(solver,-d);
+		ipasir_add(solver,a[i]);
+		ipasir_add(solver,b[i]);
+		ipasir_add(solver,0);
+		ipasir_add(solver,-d);
+		ipasir_add(solver,-a[i]);
+		ipasir_add(solver,-b[i]);
+		ipasir_add(solver,0);
+		number_of_clauses += 2;
+		differs.push_back(d);
+	}
+	ipasir_add(solver,e);
+	for (int & d : differs)
+		ipasir_add(solver,d);
+	ipasir_add(solver,0);
+	number_of_clauses++;
+}
+
 void atMostOneBinomial(void* solver, sat_capsule & capsule, std::vector<int> & is){
 	for (size_t i = 0; i < is.size(); i++){
 		int ii = is[i];
@@ -58,6 +58,10 @@ void andImplies(void* solver, int i, int j, int k, int l);
 void andImplies(void* solver, std::set<int> i, int j);
 void andImpliesNot(void* solver, int i, int j, int k);
 void atMostOne(void* solver, sat_capsule & capsule, std::vector<int> & is);
+// the binary number of the bits (least significant first) is at most max
+void atMostValue(void* solver, std::vector<int> & bits, int max);
+// e is true iff the binary numbers a and b are equal
+void equalBits(void* solver, sat_capsule & capsule, int e, std::vector<int> & a, std::vector<int> & b);
 void atLeastOne(void* solver, sat_capsule & capsule, std::vector<int> & is);
 void atMostK(void* solver, sat_capsule & capsule, int K, std::vector<int> & is);
 void notAll(void* solver, std::set<int> i);
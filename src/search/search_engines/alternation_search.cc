@@ -0,0 +1,226 @@
+#include "alternation_search.h"
+#include "search.h"
+#include "utils.h"
+
+#include "../action.h"
+#include "../task.h"
+
+#include "../open_lists/alternation_open_list.h"
+#include "../states/extensional_states.h"
+#include "../states/sparse_states.h"
+#include "../successor_generators/successor_generator.h"
+
+#include <iostream>
+#include <limits>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+template <class PackedStateT>
+bool AlternationSearch<PackedStateT>::is_progress(size_t i, int h)
+{
+    if (h == UNSOLVABLE_STATE or h >= best_values[i])
+        return false;
+    best_values[i] = h;
+    return true;
+}
+
+template <class PackedStateT>
+utils::ExitCode AlternationSearch<PackedStateT>::search(const Task &task,
+                                                        SuccessorGenerator &generator,
+                                                        Heuristic &heuristic,
+                                                        utils::Budget &budget)
+{
+    cout << "Starting greedy best first search with alternation over "
+         << 1 + extra_heuristics.size() << " heuristic(s)" << endl;
+    clock_t timer_start = clock();
+    StatePackerT packer(task);
+    if (use_orbit_search) setup_orbit_search(task, space);
+    setup_invariant_dead_ends(task);
+
+    // Open list i holds the states ordered by heuristic i, the main heuristic being the
+    // first one. With preferred operators, open list num_heuristics + i is the preferred
+    // open list of heuristic i.
+    size_t num_heuristics = 1 + extra_heuristics.size();
+    AlternationOpenList queue(use_preferred ? 2 * num_heuristics : num_heuristics);
+    best_values.assign(num_heuristics, numeric_limits<int>::max());
+
+    auto boost_preferred = [&]() {
+        if (!use_preferred)
+            return;
+        for (size_t i = 0; i < num_heuristics; ++i)
+            queue.boost_priority(num_heuristics + i, BOOST);
+    };
+
+    auto report_main_progress = [&](int h) {
+        statistics.report_f_value_progress(h); // In GBFS f = h.
+        cout << "New heuristic value expanded: h=" << h
+             << " [expansions: " << statistics.get_expanded()
+             << ", evaluations: " << statistics.get_evaluations()
+             << ", generations: " << statistics.get_generated()
+             << ", time: " << double(clock() - timer_start) / CLOCKS_PER_SEC << "]" << '\n';
+    };
+
+    // Evaluate the additional heuristics, return false if one of them detects a dead end
+    auto evaluate_extra = [&](const DBState &s, vector<int> &values) {
+        values.resize(num_heuristics);
+        for (size_t i = 1; i < num_heuristics; ++i) {
+            values[i] = extra_heuristics[i - 1]->compute_heuristic(s, task);
+            statistics.inc_evaluations();
+            if (values[i] == UNSOLVABLE_STATE)
+                return false;
+            if (is_progress(i, values[i]))
+                boost_preferred();
+        }
+        return true;
+    };
+
+    auto insert = [&](const SearchNode &node, const vector<int> &values, bool preferred) {
+        for (size_t i = 0; i < num_heuristics; ++i) {
+            // With lazy evaluation, the main heuristic value of a generated state is the
+            // one of its parent, stored in the node
+            int h = (i == 0) ? node.h : values[i];
+            queue.do_insertion(i, node.state_id, make_pair(h, node.g));
+            if (preferred)
+                queue.do_insertion(num_heuristics + i, node.state_id, make_pair(h, node.g));
+        }
+    };
+
+    SearchNode& root_node = space.insert_or_get_previous_node(packer.pack(task.initial_state), LiftedOperatorId::no_operator, StateID::no_state);
+    int h = heuristic.compute_heuristic(task.initial_state, task);
+    statistics.inc_evaluations();
+    vector<int> values;
+    if (h == UNSOLVABLE_STATE or !evaluate_extra(task.initial_state, values)) {
+        cerr << "Initial state is unsolvable!" << endl;
+        exit(1);
+    }
+    is_progress(0, h);
+    root_node.open(0, h);
+    cout << "Initial heuristic value " << h << endl;
+    statistics.report_f_value_progress(h);
+    insert(root_node, values, false);
+
+    // The useful atoms of the main heuristic belong to the last state it evaluated
+    StateID last_main_evaluation = root_node.state_id;
+    int best_expanded_h = h;
+
+    if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
+
+    while (not queue.empty()) {
+        if (budget.is_exhausted()) return budget_exhausted(budget, timer_start);
+        StateID sid = queue.remove_min();
+        bool from_main_list = size_t(queue.get_last_removed_sublist()) % num_heuristics == 0;
+        SearchNode &node = space.get_node(sid);
+        if (node.status == SearchNode::Status::CLOSED) {
+            continue;
+        }
+        node.close();
+
+        const PackedStateT &packed_state = space.get_state(sid);
+        DBState state = packer.unpack(packed_state);
+        if (is_invariant_dead_end(state)) {
+            node.mark_as_unsolvable();
+            continue;
+        }
+
+        // With lazy evaluation, the main heuristic is evaluated for states removed from its
+        // own open lists. Otherwise, states were evaluated when generated, and they are only
+        // evaluated again to compute their useful atoms.
+        bool evaluate_main = lazy_main_evaluation ? from_main_list : use_preferred;
+        if (evaluate_main and last_main_evaluation != sid) {
+            int main_h = heuristic.compute_heuristic(state, task);
+            statistics.inc_evaluations();
+            if (lazy_main_evaluation)
+                statistics.inc_evaluated_states();
+            last_main_evaluation = sid;
+            if (main_h == UNSOLVABLE_STATE) {
+                statistics.inc_dead_ends();
+                statistics.inc_pruned_states();
+                node.mark_as_unsolvable();
+                continue;
+            }
+            node.update_h(main_h);
+            if (is_progress(0, main_h)) {
+                boost_preferred();
+                report_main_progress(main_h);
+            }
+        }
+        if (!lazy_main_evaluation and node.h < best_expanded_h) {
+            best_expanded_h = node.h;
+            report_main_progress(node.h);
+        }
+        bool has_useful_atoms = use_preferred and last_main_evaluation == sid;
+        // Evaluating the successors overwrites the useful atoms of the main heuristic
+        map<int, vector<GroundAtom>> useful_atoms;
+        vector<bool> useful_nullary_atoms;
+        if (has_useful_atoms) {
+            useful_atoms = heuristic.get_useful_atoms();
+            useful_nullary_atoms = heuristic.get_useful_nullary_atoms();
+        }
+        statistics.inc_expanded();
+        int g = node.g;
+        if (is_telemetry_due(g, node.h)) emit_telemetry(space.size(), queue.size());
+
+        assert(sid.id() >= 0 && (unsigned) sid.id() < space.size());
+
+        if (check_goal(task, generator, timer_start, state, node, space)) return utils::ExitCode::SUCCESS;
+
+        for (const auto& action:task.actions) {
+            auto applicable = generator.get_applicable_actions(action, state);
+            statistics.inc_generated(applicable.size());
+
+            for (const LiftedOperatorId& op_id:applicable) {
+                DBState s = generator.generate_successor(op_id, action, state);
+                int dist = g + action.get_cost();
+                if (!evaluate_extra(s, values)) {
+                    statistics.inc_dead_ends();
+                    statistics.inc_pruned_states();
+                    continue;
+                }
+                int child_h = node.h;
+                if (!lazy_main_evaluation) {
+                    child_h = heuristic.compute_heuristic(s, task);
+                    statistics.inc_evaluations();
+                    if (child_h == UNSOLVABLE_STATE) {
+                        statistics.inc_dead_ends();
+                        statistics.inc_pruned_states();
+                        continue;
+                    }
+                    if (is_progress(0, child_h))
+                        boost_preferred();
+                }
+                bool preferred = has_useful_atoms and
+                    is_useful_operator(task, s, useful_atoms, useful_nullary_atoms);
+
+                auto &child_node = space.insert_or_get_previous_node(packer.pack(s), op_id, sid);
+                if (child_node.status == SearchNode::Status::NEW) {
+                    // Inserted for the first time in the map
+                    child_node.open(dist, child_h);
+                    if (!lazy_main_evaluation)
+                        statistics.inc_evaluated_states();
+                    insert(child_node, values, preferred);
+                }
+                else if (dist < child_node.g) {
+                    child_node.open(dist, child_h); // Reopening
+                    statistics.inc_reopened();
+                    insert(child_node, values, preferred);
+                }
+            }
+        }
+    }
+
+    print_no_solution_found(timer_start);
+
+    return utils::ExitCode::SEARCH_UNSOLVABLE;
+}
+
+template <class PackedStateT>
+void AlternationSearch<PackedStateT>::print_statistics() const {
+    statistics.print_detailed_statistics();
+    space.print_statistics();
+}
+
+// explicit template instantiations
+template class AlternationSearch<SparsePackedState>;
+template class AlternationSearch<ExtensionalPackedState>;
@@ -0,0 +1,61 @@
+#ifndef SEARCH_ALTERNATION_SEARCH_H
+#define SEARCH_ALTERNATION_SEARCH_H
+
+
+#include "search.h"
+#include "search_space.h"
+
+#include "../heuristics/heuristic.h"
+
+#include <memory>
+#include <vector>
+
+/*
+ * Greedy best-first search alternating between the open lists of several heuristics.
+ *
+ * All heuristics are evaluated when a state is generated, and each open list orders the
+ * states by the value of its own heuristic. If lazy_main_evaluation is true, the main
+ * heuristic (the one passed to search()) is instead only evaluated for states removed
+ * from one of its own open lists, and successors enter its open list with the value of
+ * their parent (deferred evaluation). The additional heuristics then keep the search
+ * moving when the main heuristic is expensive.
+ *
+ * If use_preferred is true, every heuristic also has a preferred open list with the
+ * successors reached by helpful operators of the main heuristic (see
+ * Heuristic::get_useful_atoms). Preferred open lists are boosted whenever some heuristic
+ * reaches a new best value.
+ */
+template <class PackedStateT>
+class AlternationSearch : public SearchBase {
+    static const int BOOST = 1000;
+
+protected:
+    SearchSpace<PackedStateT> space;
+
+    std::vector<std::unique_ptr<Heuristic>> extra_heuristics;
+    bool use_preferred;
+    bool lazy_main_evaluation;
+
+    // Best value of each heuristic, the main heuristic first
+    std::vector<int> best_values;
+
+    //! Record the value h of heuristic i and return true if it improves its best value
+    bool is_progress(std::size_t i, int h);
+
+public:
+    AlternationSearch(std::vector<std::unique_ptr<Heuristic>> extra_heuristics,
+                      bool use_preferred, bool lazy_main_evaluation) :
+        extra_heuristics(std::move(extra_heuristics)),
+        use_preferred(use_preferred),
+        lazy_main_evaluation(lazy_main_evaluation) {}
+
+    using StatePackerT = typename PackedStateT::StatePackerT;
+
+    utils::ExitCode search(const Task &task, SuccessorGenerator &generator, Heuristic &heuristic,
+                           utils::Budget &budget) override;
+
+    void print_statistics() const override;
+};
+
+
+#endif  // SEARCH_ALTERNATION_SEARCH_H
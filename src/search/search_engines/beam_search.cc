@@ -0,0 +1,164 @@
+#include "beam_search.h"
+
+#include "search.h"
+#include "utils.h"
+
+#include "../action.h"
+#include "../task.h"
+
+#include "../heuristics/heuristic.h"
+#include "../states/extensional_states.h"
+#include "../states/sparse_states.h"
+#include "../successor_generators/successor_generator.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+template <class PackedStateT>
+vector<LiftedOperatorId> BeamSearch<PackedStateT>::extract_plan(const shared_ptr<const PlanStep> &path)
+{
+    vector<LiftedOperatorId> plan;
+    for (const PlanStep *step = path.get(); step; step = step->parent.get())
+        plan.push_back(step->op);
+    reverse(plan.begin(), plan.end());
+    return plan;
+}
+
+template <class PackedStateT>
+bool BeamSearch<PackedStateT>::is_duplicate(const PackedStateT &state) const
+{
+    for (const StateSet &states : recent_layers) {
+        if (states.count(state) > 0)
+            return true;
+    }
+    return false;
+}
+
+template <class PackedStateT>
+utils::ExitCode BeamSearch<PackedStateT>::search(const Task &task,
+                                                 SuccessorGenerator &generator,
+                                                 Heuristic &heuristic,
+                                                 utils::Budget &budget)
+{
+    cout << "Starting beam search with width " << width << endl;
+    clock_t timer_start = clock();
+    StatePackerT packer(task);
+    setup_invariant_dead_ends(task);
+
+    int h = heuristic.compute_heuristic(task.initial_state, task);
+    if (h == UNSOLVABLE_STATE) {
+        cerr << "Initial state is unsolvable!" << endl;
+        exit(1);
+    }
+    statistics.inc_evaluations();
+    cout << "Initial heuristic value " << h << endl;
+    statistics.report_f_value_progress(h);
+
+    if (task.is_goal(task.initial_state)) {
+        print_goal_found(generator, timer_start);
+        print_plan(vector<LiftedOperatorId>(), task);
+        return utils::ExitCode::SUCCESS;
+    }
+
+    vector<BeamEntry> layer;
+    layer.push_back(BeamEntry{packer.pack(task.initial_state), h, nullptr});
+    recent_layers.emplace_back();
+    recent_layers.back().insert(layer.back().state);
+    remembered_states = 1;
+    int best_h = h;
+
+    while (not layer.empty()) {
+        ++layers;
+        if (recent_layers.size() == size_t(DUPLICATE_WINDOW)) {
+            remembered_states -= recent_layers.front().size();
+            recent_layers.pop_front();
+        }
+        recent_layers.emplace_back();
+        StateSet &generated = recent_layers.back();
+        vector<BeamEntry> candidates;
+        for (const BeamEntry &entry : layer) {
+            if (budget.is_exhausted()) return budget_exhausted(budget, timer_start);
+            DBState state = packer.unpack(entry.state);
+            statistics.inc_expanded();
+            if (is_telemetry_due(layers, entry.h)) emit_telemetry(remembered_states, layer.size());
+
+            for (const auto &action : task.actions) {
+                auto applicable = generator.get_applicable_actions(action, state);
+                statistics.inc_generated(applicable.size());
+
+                for (const LiftedOperatorId &op_id : applicable) {
+                    DBState s = generator.generate_successor(op_id, action, state);
+                    auto path = make_shared<const PlanStep>(op_id, entry.path);
+                    if (task.is_goal(s)) {
+                        print_goal_found(generator, timer_start);
+                        print_plan(extract_plan(path), task);
+                        return utils::ExitCode::SUCCESS;
+                    }
+
+                    PackedStateT child = packer.pack(s);
+                    if (is_duplicate(child))
+                        continue;
+                    generated.insert(child);
+                    ++remembered_states;
+                    if (is_invariant_dead_end(s))
+                        continue;
+
+                    int new_h = heuristic.compute_heuristic(s, task);
+                    statistics.inc_evaluations();
+                    statistics.inc_evaluated_states();
+                    if (new_h == UNSOLVABLE_STATE) {
+                        statistics.inc_dead_ends();
+                        statistics.inc_pruned_states();
+                        continue;
+                    }
+                    candidates.push_back(BeamEntry{move(child), new_h, move(path)});
+                }
+            }
+        }
+
+        // Keep the best states, ties are broken in favor of states generated first. Packed
+        // states are not assignable, so we sort their indices.
+        vector<size_t> order(candidates.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        stable_sort(order.begin(), order.end(),
+                    [&](size_t a, size_t b) { return candidates[a].h < candidates[b].h; });
+        if (order.size() > size_t(width)) {
+            statistics.inc_pruned_states(order.size() - width);
+            order.resize(width);
+        }
+        layer.clear();
+        for (size_t i : order)
+            layer.push_back(move(candidates[i]));
+
+        if (!layer.empty() and layer.front().h < best_h) {
+            best_h = layer.front().h;
+            statistics.report_f_value_progress(best_h);
+            cout << "New heuristic value expanded: h=" << best_h
+                 << " [layer: " << layers
+                 << ", expansions: " << statistics.get_expanded()
+                 << ", evaluations: " << statistics.get_evaluations()
+                 << ", generations: " << statistics.get_generated()
+                 << ", time: " << double(clock() - timer_start) / CLOCKS_PER_SEC << "]" << '\n';
+        }
+    }
+
+    cerr << "Beam search failed: layer " << layers << " has no new successors" << endl;
+    print_no_solution_found(timer_start);
+
+    return utils::ExitCode::SEARCH_UNSOLVED_INCOMPLETE;
+}
+
+template <class PackedStateT>
+void BeamSearch<PackedStateT>::print_statistics() const {
+    statistics.print_detailed_statistics();
+    cout << "Beam search layers: " << layers << endl;
+    cout << "Number of remembered states: " << remembered_states << endl;
+}
+
+// explicit template instantiations
+template class BeamSearch<SparsePackedState>;
+template class BeamSearch<ExtensionalPackedState>;
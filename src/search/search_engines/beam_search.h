@@ -0,0 +1,69 @@
+#ifndef SEARCH_BEAM_SEARCH_H
+#define SEARCH_BEAM_SEARCH_H
+
+
+#include "search.h"
+
+#include "../action.h"
+
+#include <deque>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * Beam search: a breadth-first search that only keeps the (at most) width states with the
+ * lowest heuristic values of each layer, breaking ties by generation order.
+ *
+ * Only the current layer is stored. The plans of its states share their prefixes, so a
+ * step is freed once no state of the layer descends from it anymore. Duplicates are
+ * detected against the packed states generated in the last DUPLICATE_WINDOW layers, so
+ * memory stays bounded and no unseen state is ever discarded; cycles longer than the
+ * window are not detected. The search is incomplete: it fails if a layer has no new
+ * successors.
+ */
+template <class PackedStateT>
+class BeamSearch : public SearchBase {
+    struct PlanStep {
+        LiftedOperatorId op;
+        std::shared_ptr<const PlanStep> parent;
+
+        PlanStep(LiftedOperatorId op, std::shared_ptr<const PlanStep> parent)
+            : op(std::move(op)), parent(std::move(parent)) {}
+    };
+
+    struct BeamEntry {
+        PackedStateT state;
+        int h;
+        std::shared_ptr<const PlanStep> path;
+    };
+
+    using StateSet = std::unordered_set<PackedStateT, typename PackedStateT::HashT>;
+
+    static const int DUPLICATE_WINDOW = 8;
+
+    static std::vector<LiftedOperatorId> extract_plan(const std::shared_ptr<const PlanStep> &path);
+
+    bool is_duplicate(const PackedStateT &state) const;
+
+protected:
+    int width;
+    int layers;
+
+    //! Packed states generated in the last DUPLICATE_WINDOW layers, the newest last
+    std::deque<StateSet> recent_layers;
+    std::size_t remembered_states;
+
+public:
+    explicit BeamSearch(int width) : width(width), layers(0), remembered_states(0) {}
+
+    using StatePackerT = typename PackedStateT::StatePackerT;
+
+    utils::ExitCode search(const Task &task, SuccessorGenerator &generator, Heuristic &heuristic,
+                           utils::Budget &budget) override;
+
+    void print_statistics() const override;
+};
+
+
+#endif  // SEARCH_BEAM_SEARCH_H
@@ -1,13 +1,15 @@
 
 #include "breadth_first_search.h"
+#include "checkpoint.h"
 #include "../states/extensional_states.h"
 #include "../states/sparse_states.h"
 #include "../successor_generators/successor_generator.h"
 #include "../task.h"
 #include "utils.h"
 
+#include <deque>
 #include <iostream>
-#include <queue>
+#include <memory>
 #include <vector>
 
 using namespace std;
@@ -15,25 +17,54 @@ using namespace std;
 template <class PackedStateT>
 utils::ExitCode BreadthFirstSearch<PackedStateT>::search(const Task &task,
                                              SuccessorGenerator &generator,
-                                             Heuristic &heuristic)
+                                             Heuristic &heuristic,
+                                             utils::Budget &budget)
 {
     cout << "Starting breadth first search" << endl;
     clock_t timer_start = clock();
 
     StatePackerT packer(task);
-    std::queue<StateID> queue;
-
-    SearchNode& root_node = space.insert_or_get_previous_node(packer.pack(task.initial_state), LiftedOperatorId::no_operator, StateID::no_state);
-    root_node.open(0);
-    cout << "Initial heuristic value 0" << endl;
-    statistics.report_f_value_progress(root_node.f);
-    queue.emplace(root_node.state_id);
-
-    if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
+    deque<StateID> queue;
+    if (use_stubborn_sets) stubborn_sets = std::make_unique<StubbornSets>(task);
+    if (use_orbit_search) setup_orbit_search(task, space);
+    setup_invariant_dead_ends(task);
+
+    unique_ptr<Checkpoint<PackedStateT>> checkpoint;
+    if (!checkpoint_file.empty())
+        checkpoint = make_unique<Checkpoint<PackedStateT>>(checkpoint_file, checkpoint_interval, task, "bfs");
+    auto save_checkpoint = [&]() {
+        vector<OpenListEntry> entries;
+        for (const StateID &id : queue)
+            entries.push_back(OpenListEntry{id.id(), 0, space.get_node(id).f});
+        checkpoint->save(space, entries, statistics, {});
+    };
+
+    vector<OpenListEntry> entries;
+    vector<int> engine_values;
+    if (resume_from_checkpoint and checkpoint->load(space, entries, statistics, engine_values)) {
+        for (const OpenListEntry &entry : entries)
+            queue.push_back(space.node_at(entry.state).state_id);
+    }
+    else {
+        SearchNode& root_node = space.insert_or_get_previous_node(packer.pack(task.initial_state), LiftedOperatorId::no_operator, StateID::no_state);
+        root_node.open(0);
+        cout << "Initial heuristic value 0" << endl;
+        statistics.report_f_value_progress(root_node.f);
+        queue.push_back(root_node.state_id);
+
+        if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
+    }
 
     while (not queue.empty()) {
+        if (checkpoint and checkpoint->is_due()) save_checkpoint();
+        if (budget.is_exhausted()) {
+            // Keep the search done so far, so it can be resumed with a larger budget
+            if (checkpoint) save_checkpoint();
+            return budget_exhausted(budget, timer_start);
+        }
+
         StateID sid = queue.front();
-        queue.pop();
+        queue.pop_front();
         SearchNode &node = space.get_node(sid);
         if (node.status == SearchNode::Status::CLOSED) {
             continue;
@@ -41,26 +72,61 @@ utils::ExitCode BreadthFirstSearch<PackedStateT>::search(const Task &task,
         node.close();
         statistics.report_f_value_progress(node.f);
         statistics.inc_expanded();
+        if (is_telemetry_due(node.f, 0)) emit_telemetry(space.size(), queue.size());
 
         assert(sid.id() >= 0 && (unsigned) sid.id() < space.size());
 
-        DBState state = packer.unpack(space.get_state(sid));
+        const PackedStateT &packed_state = space.get_state(sid);
+        DBState state = packer.unpack(packed_state);
+        if (is_invariant_dead_end(state)) continue;
+
+        if (stubborn_sets) stubborn_sets->compute_stubborn_set(state, generator);
 
         // Let's expand the state, one schema at a time. If necessary, i.e. if it really helps
         // performance, we could implement some form of std iterator
         for (const auto& action:task.actions) {
-            auto applicable = generator.get_applicable_actions(action, state);
+            if (stubborn_sets and !stubborn_sets->is_stubborn(action)) continue;
+            vector<LiftedOperatorId> applicable;
+            if (stubborn_sets) {
+                applicable = move(stubborn_sets->get_applicable_actions(action));
+            }
+            else if constexpr (is_extensional<PackedStateT>) {
+                // Ground schemas are checked with the precondition masks of the packer
+                if (!action.is_ground())
+                    applicable = generator.get_applicable_actions(action, state);
+                else if (packer.is_ground_action_applicable(action, packed_state))
+                    applicable.emplace_back(action.get_index(), vector<int>());
+            }
+            else {
+                applicable = generator.get_applicable_actions(action, state);
+            }
             statistics.inc_generated(applicable.size());
 
             for (const LiftedOperatorId &op_id:applicable) {
-                DBState s = generator.generate_successor(op_id, action, state);
-                auto& child_node = space.insert_or_get_previous_node(packer.pack(s), op_id, node.state_id);
-                if (child_node.status == SearchNode::Status::NEW) {
-                    child_node.open(node.f+1);
+                if constexpr (is_extensional<PackedStateT>) {
+                    // Apply the operator and test the goal on the bitset, without creating a DBState
+                    auto& child_node = space.insert_or_get_previous_node(
+                        packer.generate_successor(op_id, action, packed_state), op_id, node.state_id);
+                    if (child_node.status == SearchNode::Status::NEW) {
+                        child_node.open(node.f+1);
+
+                        if (check_goal(task, packer, generator, timer_start,
+                                       space.get_state(child_node.state_id), child_node, space))
+                            return utils::ExitCode::SUCCESS;
+
+                        queue.push_back(child_node.state_id);
+                    }
+                }
+                else {
+                    DBState s = generator.generate_successor(op_id, action, state);
+                    auto& child_node = space.insert_or_get_previous_node(packer.pack(s), op_id, node.state_id);
+                    if (child_node.status == SearchNode::Status::NEW) {
+                        child_node.open(node.f+1);
 
-                    if (check_goal(task, generator, timer_start, s, child_node, space)) return utils::ExitCode::SUCCESS;
+                        if (check_goal(task, generator, timer_start, s, child_node, space)) return utils::ExitCode::SUCCESS;
 
-                    queue.emplace(child_node.state_id);
+                        queue.push_back(child_node.state_id);
+                    }
                 }
             }
         }
@@ -75,6 +141,7 @@ template <class PackedStateT>
 void BreadthFirstSearch<PackedStateT>::print_statistics() const {
     statistics.print_detailed_statistics();
     space.print_statistics();
+    if (stubborn_sets) stubborn_sets->print_statistics();
 }
 
 // explicit template instantiations
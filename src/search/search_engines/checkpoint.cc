@@ -0,0 +1,316 @@
+#include "checkpoint.h"
+
+#include "../action.h"
+#include "../search_statistics.h"
+#include "../task.h"
+
+#include "../states/extensional_states.h"
+#include "../states/sparse_states.h"
+#include "../utils/binary_io.h"
+#include "../utils/hash.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+static const char SEGMENT_MAGIC[8] = {'P', 'L', 'C', 'K', 'S', 'E', 'G', '1'};
+static const char SNAPSHOT_MAGIC[8] = {'P', 'L', 'C', 'K', 'S', 'N', 'P', '2'};
+
+static void write_magic(ostream &out, const char *magic) {
+    out.write(magic, 8);
+}
+
+static bool read_magic(istream &in, const char *magic) {
+    char buffer[8];
+    in.read(buffer, 8);
+    return in and memcmp(buffer, magic, 8) == 0;
+}
+
+static void checkpoint_error(const string &filename, const string &message) {
+    cerr << "Error reading checkpoint " << filename << ": " << message << endl;
+    exit(-1);
+}
+
+static void write_state(ostream &out, const SparsePackedState &state) {
+    utils::write_binary<uint64_t>(out, state.packed_relations.size());
+    for (const vector<long> &relation : state.packed_relations)
+        utils::write_binary_vector(out, relation);
+    utils::write_binary_vector(out, state.predicate_symbols);
+    vector<uint8_t> nullary_atoms(state.nullary_atoms.begin(), state.nullary_atoms.end());
+    utils::write_binary_vector(out, nullary_atoms);
+}
+
+static void write_state(ostream &out, const ExtensionalPackedState &state) {
+    // Eight atoms per byte
+    vector<uint8_t> bytes((state.atoms.size() + 7) / 8, 0);
+    for (size_t i = 0; i < state.atoms.size(); ++i) {
+        if (state.atoms.test(i))
+            bytes[i / 8] |= uint8_t(1) << (i % 8);
+    }
+    utils::write_binary<uint64_t>(out, state.atoms.size());
+    utils::write_binary_vector(out, bytes);
+}
+
+template <class PackedStateT>
+static PackedStateT read_state(istream &in);
+
+template <>
+SparsePackedState read_state<SparsePackedState>(istream &in) {
+    SparsePackedState state;
+    // Every relation stores at least its length
+    uint64_t num_relations = utils::read_binary<uint64_t>(in);
+    if (num_relations > UINT64_MAX / sizeof(uint64_t) or
+        !utils::has_bytes_left(in, num_relations * sizeof(uint64_t))) {
+        in.setstate(ios::failbit);
+        return state;
+    }
+    state.packed_relations.resize(num_relations);
+    for (vector<long> &relation : state.packed_relations)
+        relation = utils::read_binary_vector<long>(in);
+    state.predicate_symbols = utils::read_binary_vector<int>(in);
+    vector<uint8_t> nullary_atoms = utils::read_binary_vector<uint8_t>(in);
+    state.nullary_atoms.assign(nullary_atoms.begin(), nullary_atoms.end());
+    return state;
+}
+
+template <>
+ExtensionalPackedState read_state<ExtensionalPackedState>(istream &in) {
+    uint64_t num_atoms = utils::read_binary<uint64_t>(in);
+    if (!utils::has_bytes_left(in, num_atoms / 8)) {
+        in.setstate(ios::failbit);
+        return ExtensionalPackedState(0);
+    }
+    ExtensionalPackedState state(num_atoms);
+    vector<uint8_t> bytes = utils::read_binary_vector<uint8_t>(in);
+    if (bytes.size() != (state.atoms.size() + 7) / 8) {
+        in.setstate(ios::failbit);
+        return state;
+    }
+    for (size_t i = 0; i < state.atoms.size(); ++i) {
+        if (bytes[i / 8] & (uint8_t(1) << (i % 8)))
+            state.atoms.set(i);
+    }
+    return state;
+}
+
+template <class PackedStateT>
+static const char *state_representation_name();
+
+template <>
+const char *state_representation_name<SparsePackedState>() {
+    return "sparse";
+}
+
+template <>
+const char *state_representation_name<ExtensionalPackedState>() {
+    return "extensional";
+}
+
+static void feed_string(utils::HashState &hash_state, const string &s) {
+    utils::feed(hash_state, static_cast<uint64_t>(s.size()));
+    for (char c : s)
+        utils::feed(hash_state, static_cast<int>(c));
+}
+
+template <class PackedStateT>
+Checkpoint<PackedStateT>::Checkpoint(const string &filename, double interval_in_seconds,
+                                     const Task &task, const string &engine_name)
+    : filename(filename),
+      snapshot_filename(filename + ".snapshot"),
+      interval(chrono::duration_cast<chrono::steady_clock::duration>(
+          chrono::duration<double>(interval_in_seconds))),
+      saved_nodes(0),
+      segment_bytes(0),
+      calls_since_clock_check(0),
+      last_save(chrono::steady_clock::now())
+{
+    utils::HashState hash_state;
+    feed_string(hash_state, engine_name);
+    feed_string(hash_state, state_representation_name<PackedStateT>());
+    feed_string(hash_state, task.get_domain_name());
+    feed_string(hash_state, task.get_task_name());
+    utils::feed(hash_state, static_cast<uint64_t>(task.actions.size()));
+    utils::feed(hash_state, static_cast<uint64_t>(task.objects.size()));
+    utils::feed(hash_state, static_cast<uint64_t>(task.predicates.size()));
+    fingerprint = hash_state.get_hash64();
+}
+
+template <class PackedStateT>
+bool Checkpoint<PackedStateT>::is_due()
+{
+    // Reading the clock at every expansion is too expensive for cheap heuristics
+    if (++calls_since_clock_check < 256)
+        return false;
+    calls_since_clock_check = 0;
+    return chrono::steady_clock::now() - last_save >= interval;
+}
+
+template <class PackedStateT>
+void Checkpoint<PackedStateT>::save(const SearchSpace<PackedStateT> &space,
+                                    const vector<OpenListEntry> &open_list,
+                                    const SearchStatistics &statistics,
+                                    const vector<int> &engine_values)
+{
+    auto start = chrono::steady_clock::now();
+    size_t num_nodes = space.size();
+
+    // Append the new states to the segment file, writing its header first if it is new
+    {
+        ofstream out;
+        if (segment_bytes == 0) {
+            out.open(filename, ios::binary | ios::trunc);
+            write_magic(out, SEGMENT_MAGIC);
+            utils::write_binary<uint64_t>(out, fingerprint);
+        } else {
+            out.open(filename, ios::binary | ios::app);
+        }
+        utils::write_binary<uint64_t>(out, saved_nodes);
+        utils::write_binary<uint64_t>(out, num_nodes - saved_nodes);
+        for (size_t i = saved_nodes; i < num_nodes; ++i) {
+            const SearchNode &node = space.node_at(i);
+            write_state(out, space.get_state(node.state_id));
+            utils::write_binary<int>(out, node.op.get_index());
+            utils::write_binary_vector(out, node.op.get_instantiation());
+            utils::write_binary<int>(out, node.parent_state_id.id());
+        }
+        out.close();
+        if (!out) {
+            cerr << "Error writing checkpoint " << filename << endl;
+            exit(-1);
+        }
+    }
+    segment_bytes = filesystem::file_size(filename);
+    saved_nodes = num_nodes;
+
+    // Rewrite the snapshot of the mutable data
+    string tmp_filename = snapshot_filename + ".tmp";
+    {
+        vector<uint8_t> status(num_nodes);
+        vector<int> f(num_nodes), g(num_nodes), h(num_nodes);
+        for (size_t i = 0; i < num_nodes; ++i) {
+            const SearchNode &node = space.node_at(i);
+            status[i] = node.status;
+            f[i] = node.f;
+            g[i] = node.g;
+            h[i] = node.h;
+        }
+
+        ofstream out(tmp_filename, ios::binary | ios::trunc);
+        write_magic(out, SNAPSHOT_MAGIC);
+        utils::write_binary<uint64_t>(out, fingerprint);
+        utils::write_binary<uint64_t>(out, segment_bytes);
+        utils::write_binary_vector(out, status);
+        utils::write_binary_vector(out, f);
+        utils::write_binary_vector(out, g);
+        utils::write_binary_vector(out, h);
+        utils::write_binary_vector(out, open_list);
+        statistics.save(out);
+        utils::write_binary_vector(out, engine_values);
+        write_magic(out, SNAPSHOT_MAGIC);
+        out.close();
+        if (!out) {
+            cerr << "Error writing checkpoint " << snapshot_filename << endl;
+            exit(-1);
+        }
+    }
+    if (rename(tmp_filename.c_str(), snapshot_filename.c_str()) != 0) {
+        cerr << "Error renaming checkpoint " << tmp_filename << endl;
+        exit(-1);
+    }
+
+    last_save = chrono::steady_clock::now();
+    cout << "Checkpoint saved: " << num_nodes << " states, " << open_list.size()
+         << " open list entries [" << segment_bytes << " bytes, "
+         << chrono::duration<double>(last_save - start).count() << "s]" << endl;
+}
+
+template <class PackedStateT>
+bool Checkpoint<PackedStateT>::load(SearchSpace<PackedStateT> &space,
+                                    vector<OpenListEntry> &open_list,
+                                    SearchStatistics &statistics,
+                                    vector<int> &engine_values)
+{
+    assert(space.size() == 0);
+    ifstream snapshot(snapshot_filename, ios::binary);
+    if (!snapshot) {
+        cout << "No checkpoint found in " << filename << ", starting from scratch" << endl;
+        return false;
+    }
+    if (!read_magic(snapshot, SNAPSHOT_MAGIC))
+        checkpoint_error(snapshot_filename, "not a snapshot file");
+    if (utils::read_binary<uint64_t>(snapshot) != fingerprint)
+        checkpoint_error(snapshot_filename, "it was written for another task or search configuration");
+    uint64_t recorded_segment_bytes = utils::read_binary<uint64_t>(snapshot);
+    vector<uint8_t> status = utils::read_binary_vector<uint8_t>(snapshot);
+    vector<int> f = utils::read_binary_vector<int>(snapshot);
+    vector<int> g = utils::read_binary_vector<int>(snapshot);
+    vector<int> h = utils::read_binary_vector<int>(snapshot);
+    open_list = utils::read_binary_vector<OpenListEntry>(snapshot);
+    statistics.load(snapshot);
+    engine_values = utils::read_binary_vector<int>(snapshot);
+    if (!read_magic(snapshot, SNAPSHOT_MAGIC))
+        checkpoint_error(snapshot_filename, "truncated snapshot");
+    size_t num_nodes = status.size();
+    if (f.size() != num_nodes or g.size() != num_nodes or h.size() != num_nodes)
+        checkpoint_error(snapshot_filename, "inconsistent node table");
+
+    ifstream segments(filename, ios::binary);
+    if (!read_magic(segments, SEGMENT_MAGIC))
+        checkpoint_error(filename, "not a segment file");
+    if (utils::read_binary<uint64_t>(segments) != fingerprint)
+        checkpoint_error(filename, "it does not belong to the snapshot");
+    // Register the states again, in the same order, so they keep their ids
+    while (segments and uint64_t(segments.tellg()) < recorded_segment_bytes) {
+        uint64_t first = utils::read_binary<uint64_t>(segments);
+        uint64_t count = utils::read_binary<uint64_t>(segments);
+        if (!segments or first != space.size())
+            checkpoint_error(filename, "unexpected segment");
+        for (uint64_t i = 0; i < count; ++i) {
+            PackedStateT state = read_state<PackedStateT>(segments);
+            int op_index = utils::read_binary<int>(segments);
+            vector<int> instantiation = utils::read_binary_vector<int>(segments);
+            int parent = utils::read_binary<int>(segments);
+            if (!segments or parent >= int(space.size()))
+                checkpoint_error(filename, "truncated segment");
+            StateID parent_id = (parent < 0) ? StateID::no_state : space.node_at(parent).state_id;
+            size_t expected_id = space.size();
+            SearchNode &node = space.insert_or_get_previous_node(
+                move(state), LiftedOperatorId(op_index, move(instantiation)), parent_id);
+            if (node.state_id.id() != int(expected_id))
+                checkpoint_error(filename, "duplicate state");
+        }
+    }
+    if (!segments or uint64_t(segments.tellg()) != recorded_segment_bytes or space.size() != num_nodes)
+        checkpoint_error(filename, "the states do not match the snapshot");
+    segments.close();
+
+    // Drop what was appended after the snapshot, so the next segment follows this one
+    filesystem::resize_file(filename, recorded_segment_bytes);
+    segment_bytes = recorded_segment_bytes;
+    saved_nodes = num_nodes;
+
+    for (size_t i = 0; i < num_nodes; ++i) {
+        SearchNode &node = space.node_at(i);
+        node.status = status[i];
+        node.f = f[i];
+        node.g = g[i];
+        node.h = h[i];
+    }
+    for (const OpenListEntry &entry : open_list) {
+        if (entry.state < 0 or size_t(entry.state) >= num_nodes)
+            checkpoint_error(snapshot_filename, "open list entry out of range");
+    }
+
+    last_save = chrono::steady_clock::now();
+    cout << "Resuming from checkpoint " << filename << ": " << num_nodes << " states, "
+         << open_list.size() << " open list entries" << endl;
+    return true;
+}
+
+// explicit template instantiations
+template class Checkpoint<SparsePackedState>;
+template class Checkpoint<ExtensionalPackedState>;
@@ -0,0 +1,78 @@
+#ifndef SEARCH_CHECKPOINT_H
+#define SEARCH_CHECKPOINT_H
+
+#include "search_space.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class SearchStatistics;
+class Task;
+
+struct OpenListEntry {
+    int state;
+    int h;
+    int g;
+};
+
+/*
+ * Periodic checkpoints of a search, so it can be resumed after the process is killed.
+ *
+ * A checkpoint is made of two files. The segment file (the given file name) holds the
+ * registered states together with the immutable part of their nodes (creating operator
+ * and parent). It starts with a header and every checkpoint appends a segment with the
+ * states registered since the previous one. The snapshot file (file name + ".snapshot")
+ * holds everything that changes during the search: the status, f, g and h values of all
+ * nodes, the open list, the statistics and some values of the engine. It is rewritten
+ * atomically (written to a temporary file, then renamed) after the segment was appended,
+ * and records the size of the segment file, so a segment that was only partially written
+ * is discarded when resuming.
+ *
+ * The hash set of the registered states is not stored: it is rebuilt by registering the
+ * states again when loading the checkpoint. Orbit search is not supported.
+ */
+template <class PackedStateT>
+class Checkpoint {
+    std::string filename;
+    std::string snapshot_filename;
+    std::chrono::steady_clock::duration interval;
+    std::uint64_t fingerprint;
+
+    // Number of nodes and bytes already stored in the segment file
+    std::size_t saved_nodes;
+    std::uint64_t segment_bytes;
+
+    int calls_since_clock_check;
+    std::chrono::steady_clock::time_point last_save;
+
+public:
+    /*
+     * The fingerprint of the engine name, the state representation and the task is stored
+     * in the checkpoint, so that a checkpoint is only loaded by the same configuration.
+     */
+    Checkpoint(const std::string &filename, double interval_in_seconds,
+               const Task &task, const std::string &engine_name);
+
+    //! Return true if the interval elapsed since the last checkpoint (or the start)
+    bool is_due();
+
+    void save(const SearchSpace<PackedStateT> &space,
+              const std::vector<OpenListEntry> &open_list,
+              const SearchStatistics &statistics,
+              const std::vector<int> &engine_values);
+
+    /*
+     * Load the last checkpoint into an empty search space. Return false if there is no
+     * checkpoint to resume from. Exit with an error if the checkpoint is corrupted or was
+     * written by another configuration.
+     */
+    bool load(SearchSpace<PackedStateT> &space,
+              std::vector<OpenListEntry> &open_list,
+              SearchStatistics &statistics,
+              std::vector<int> &engine_values);
+};
+
+
+#endif  // SEARCH_CHECKPOINT_H
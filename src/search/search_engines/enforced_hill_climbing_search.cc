@@ -0,0 +1,157 @@
+#include "enforced_hill_climbing_search.h"
+
+#include "search.h"
+#include "utils.h"
+
+#include "../action.h"
+#include "../task.h"
+
+#include "../heuristics/heuristic.h"
+#include "../states/extensional_states.h"
+#include "../states/sparse_states.h"
+#include "../successor_generators/successor_generator.h"
+
+#include <iostream>
+#include <queue>
+#include <vector>
+
+using namespace std;
+
+template <class PackedStateT>
+utils::ExitCode EnforcedHillClimbingSearch<PackedStateT>::search(const Task &task,
+                                                                 SuccessorGenerator &generator,
+                                                                 Heuristic &heuristic,
+                                                                 utils::Budget &budget)
+{
+    cout << "Starting enforced hill-climbing search" << endl;
+    clock_t timer_start = clock();
+    StatePackerT packer(task);
+    setup_invariant_dead_ends(task);
+
+    heuristic_layer = heuristic.compute_heuristic(task.initial_state, task);
+    if (heuristic_layer == UNSOLVABLE_STATE) {
+        cerr << "Initial state is unsolvable!" << endl;
+        exit(1);
+    }
+    statistics.inc_evaluations();
+    cout << "Initial heuristic value " << heuristic_layer << endl;
+    statistics.report_f_value_progress(heuristic_layer);
+
+    auto solution_found = [&](const SearchNode &node, const LiftedOperatorId *last_op) {
+        print_goal_found(generator, timer_start);
+        vector<LiftedOperatorId> plan = plan_prefix;
+        for (const LiftedOperatorId &op : space->extract_plan(node))
+            plan.push_back(op);
+        if (last_op)
+            plan.push_back(*last_op);
+        print_plan(plan, task);
+        return utils::ExitCode::SUCCESS;
+    };
+
+    DBState current = task.initial_state;
+    int current_g = 0;
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        ++phases;
+        space = make_unique<SearchSpace<PackedStateT>>();
+        queue<StateID> open;
+
+        SearchNode &root_node = space->insert_or_get_previous_node(
+            packer.pack(current), LiftedOperatorId::no_operator, StateID::no_state);
+        root_node.open(current_g, heuristic_layer);
+        StateID root_id = root_node.state_id;
+        open.push(root_id);
+
+        if (task.is_goal(current)) return solution_found(root_node, nullptr);
+
+        while (not open.empty()) {
+            if (budget.is_exhausted()) return budget_exhausted(budget, timer_start);
+            StateID sid = open.front();
+            open.pop();
+            SearchNode &node = space->get_node(sid);
+            if (node.status == SearchNode::Status::CLOSED) {
+                continue;
+            }
+            node.close();
+            DBState state = packer.unpack(space->get_state(sid));
+
+            // States are evaluated when expanded and the root was the last state evaluated,
+            // so the useful atoms of the heuristic always belong to the expanded state
+            if (sid != root_id) {
+                if (is_invariant_dead_end(state)) {
+                    node.mark_as_unsolvable();
+                    continue;
+                }
+                int h = heuristic.compute_heuristic(state, task);
+                statistics.inc_evaluations();
+                statistics.inc_evaluated_states();
+                if (h == UNSOLVABLE_STATE) {
+                    statistics.inc_dead_ends();
+                    statistics.inc_pruned_states();
+                    node.mark_as_unsolvable();
+                    continue;
+                }
+                node.update_h(h);
+                if (h < heuristic_layer) {
+                    heuristic_layer = h;
+                    statistics.report_f_value_progress(h);
+                    cout << "New heuristic value expanded: h=" << h
+                         << " [expansions: " << statistics.get_expanded()
+                         << ", evaluations: " << statistics.get_evaluations()
+                         << ", generations: " << statistics.get_generated()
+                         << ", time: " << double(clock() - timer_start) / CLOCKS_PER_SEC << "]" << '\n';
+                    for (const LiftedOperatorId &op : space->extract_plan(node))
+                        plan_prefix.push_back(op);
+                    current = move(state);
+                    current_g = node.g;
+                    improved = true;
+                    break;
+                }
+            }
+            statistics.inc_expanded();
+            int g = node.g;
+            if (is_telemetry_due(g, node.h)) emit_telemetry(space->size(), open.size());
+            StateID parent_id = node.state_id;
+
+            for (const auto &action : task.actions) {
+                auto applicable = generator.get_applicable_actions(action, state);
+                statistics.inc_generated(applicable.size());
+
+                for (const LiftedOperatorId &op_id : applicable) {
+                    DBState s = generator.generate_successor(op_id, action, state);
+                    if (prune_relaxed_useless_operators and
+                        not is_useful_operator(task, s, heuristic.get_useful_atoms(), heuristic.get_useful_nullary_atoms())) {
+                        statistics.inc_pruned_states();
+                        continue;
+                    }
+                    if (task.is_goal(s)) return solution_found(space->get_node(parent_id), &op_id);
+
+                    auto &child_node = space->insert_or_get_previous_node(packer.pack(s), op_id, parent_id);
+                    if (child_node.status == SearchNode::Status::NEW) {
+                        // The parent value is only a placeholder until the child is expanded
+                        child_node.open(g + action.get_cost(), heuristic_layer);
+                        open.push(child_node.state_id);
+                    }
+                }
+            }
+        }
+    }
+
+    cerr << "Enforced hill-climbing failed: no state with h < " << heuristic_layer
+         << " reachable from the current state" << endl;
+    print_no_solution_found(timer_start);
+
+    return utils::ExitCode::SEARCH_UNSOLVED_INCOMPLETE;
+}
+
+template <class PackedStateT>
+void EnforcedHillClimbingSearch<PackedStateT>::print_statistics() const {
+    statistics.print_detailed_statistics();
+    cout << "Enforced hill-climbing phases: " << phases << endl;
+    if (space) space->print_statistics();
+}
+
+// explicit template instantiations
+template class EnforcedHillClimbingSearch<SparsePackedState>;
+template class EnforcedHillClimbingSearch<ExtensionalPackedState>;
@@ -0,0 +1,46 @@
+#ifndef SEARCH_ENFORCED_HILL_CLIMBING_SEARCH_H
+#define SEARCH_ENFORCED_HILL_CLIMBING_SEARCH_H
+
+
+#include "search.h"
+#include "search_space.h"
+
+#include <memory>
+#include <vector>
+
+/*
+ * Enforced hill-climbing (Hoffmann and Nebel, JAIR 2001): starting from the current state,
+ * run a breadth-first search until a state with a strictly lower heuristic value is found,
+ * which becomes the new current state. States are evaluated when they are expanded.
+ *
+ * Each breadth-first phase uses its own search space, so only the states of the current
+ * phase are stored. If prune_relaxed_useless_operators is true, only successors reached by
+ * helpful actions (see Heuristic::get_useful_atoms) are generated. The search is
+ * incomplete: it fails if a phase does not find a better state.
+ */
+template <class PackedStateT>
+class EnforcedHillClimbingSearch : public SearchBase {
+protected:
+    std::unique_ptr<SearchSpace<PackedStateT>> space;
+
+    int heuristic_layer{};
+    bool prune_relaxed_useless_operators;
+    int phases;
+
+    // Plan from the initial state to the root of the current phase
+    std::vector<LiftedOperatorId> plan_prefix;
+
+public:
+    explicit EnforcedHillClimbingSearch(bool prune) :
+        prune_relaxed_useless_operators(prune), phases(0) {}
+
+    using StatePackerT = typename PackedStateT::StatePackerT;
+
+    utils::ExitCode search(const Task &task, SuccessorGenerator &generator, Heuristic &heuristic,
+                           utils::Budget &budget) override;
+
+    void print_statistics() const override;
+};
+
+
+#endif  // SEARCH_ENFORCED_HILL_CLIMBING_SEARCH_H
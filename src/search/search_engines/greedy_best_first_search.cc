@@ -1,4 +1,5 @@
 #include "greedy_best_first_search.h"
+#include "checkpoint.h"
 #include "search.h"
 #include "utils.h"
 
@@ -14,6 +15,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <vector>
 
@@ -22,32 +24,73 @@ using namespace std;
 template <class PackedStateT>
 utils::ExitCode GreedyBestFirstSearch<PackedStateT>::search(const Task &task,
                                                 SuccessorGenerator &generator,
-                                                Heuristic &heuristic)
+                                                Heuristic &heuristic,
+                                                utils::Budget &budget)
 {
     cout << "Starting greedy best first search" << endl;
     clock_t timer_start = clock();
     StatePackerT packer(task);
+    if (use_stubborn_sets) stubborn_sets = std::make_unique<StubbornSets>(task);
+    if (use_orbit_search) setup_orbit_search(task, space);
+    setup_invariant_dead_ends(task);
 
     GreedyOpenList queue;
 
-    SearchNode& root_node = space.insert_or_get_previous_node(packer.pack(task.initial_state), LiftedOperatorId::no_operator, StateID::no_state);
-    utils::Timer t;
-    heuristic_layer = heuristic.compute_heuristic(task.initial_state, task);
-    t.stop();
-    cout << "Time to evaluate initial state: " << t() << endl;
-    root_node.open(0, heuristic_layer);
-    if (heuristic_layer == numeric_limits<int>::max()) {
-        cerr << "Initial state is unsolvable!" << endl;
-        exit(1);
+    unique_ptr<Checkpoint<PackedStateT>> checkpoint;
+    if (!checkpoint_file.empty())
+        checkpoint = make_unique<Checkpoint<PackedStateT>>(checkpoint_file, checkpoint_interval, task, "gbfs");
+    auto save_checkpoint = [&]() {
+        vector<OpenListEntry> entries;
+        queue.for_each([&](const StateID &id, const pair<int, int> &key) {
+            entries.push_back(OpenListEntry{id.id(), key.first, key.second});
+        });
+        checkpoint->save(space, entries, statistics, {heuristic_layer});
+    };
+
+    vector<OpenListEntry> entries;
+    vector<int> engine_values;
+    if (resume_from_checkpoint and checkpoint->load(space, entries, statistics, engine_values)) {
+        heuristic_layer = engine_values.at(0);
+        for (const OpenListEntry &entry : entries)
+            queue.do_insertion(space.node_at(entry.state).state_id, make_pair(entry.h, entry.g));
+    }
+    else {
+        SearchNode& root_node = space.insert_or_get_previous_node(packer.pack(task.initial_state), LiftedOperatorId::no_operator, StateID::no_state);
+        utils::Timer t;
+        heuristic_layer = heuristic.compute_heuristic(task.initial_state, task);
+        t.stop();
+        cout << "Time to evaluate initial state: " << t() << endl;
+        root_node.open(0, heuristic_layer);
+        if (heuristic_layer == numeric_limits<int>::max()) {
+            cerr << "Initial state is unsolvable!" << endl;
+            exit(1);
+        }
+        statistics.inc_evaluations();
+        cout << "Initial heuristic value " << heuristic_layer << endl;
+        statistics.report_f_value_progress(heuristic_layer);
+        queue.do_insertion(root_node.state_id, make_pair(heuristic_layer, 0));
+
+        if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
     }
-    statistics.inc_evaluations();
-    cout << "Initial heuristic value " << heuristic_layer << endl;
-    statistics.report_f_value_progress(heuristic_layer);
-    queue.do_insertion(root_node.state_id, make_pair(heuristic_layer, 0));
 
-    if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
+    // Count the evaluation of a successor and check if it can be pruned
+    auto is_dead_end = [&](int h) {
+        statistics.inc_evaluations();
+        if (h != UNSOLVABLE_STATE)
+            return false;
+        statistics.inc_dead_ends();
+        statistics.inc_pruned_states();
+        return true;
+    };
 
     while (not queue.empty()) {
+        if (checkpoint and checkpoint->is_due()) save_checkpoint();
+        if (budget.is_exhausted()) {
+            // Keep the search done so far, so it can be resumed with a larger budget
+            if (checkpoint) save_checkpoint();
+            return budget_exhausted(budget, timer_start);
+        }
+
         StateID sid = queue.remove_min();
         SearchNode &node = space.get_node(sid);
         int h = node.h;
@@ -58,6 +101,7 @@ utils::ExitCode GreedyBestFirstSearch<PackedStateT>::search(const Task &task,
         node.close();
         statistics.report_f_value_progress(h); // In GBFS f = h.
         statistics.inc_expanded();
+        if (is_telemetry_due(g, h)) emit_telemetry(space.size(), queue.size());
 
         if (h < heuristic_layer) {
             heuristic_layer = h;
@@ -69,41 +113,72 @@ utils::ExitCode GreedyBestFirstSearch<PackedStateT>::search(const Task &task,
         }
         assert(sid.id() >= 0 && (unsigned) sid.id() < space.size());
 
-        DBState state = packer.unpack(space.get_state(sid));
-        if (check_goal(task, generator, timer_start, state, node, space)) return utils::ExitCode::SUCCESS;
+        const PackedStateT &packed_state = space.get_state(sid);
+        if constexpr (is_extensional<PackedStateT>) {
+            if (check_goal(task, packer, generator, timer_start, packed_state, node, space)) return utils::ExitCode::SUCCESS;
+        }
+        DBState state = packer.unpack(packed_state);
+        if constexpr (!is_extensional<PackedStateT>) {
+            if (check_goal(task, generator, timer_start, state, node, space)) return utils::ExitCode::SUCCESS;
+        }
+        if (is_invariant_dead_end(state)) continue;
+
+        if (stubborn_sets) stubborn_sets->compute_stubborn_set(state, generator);
 
         // Let's expand the state, one schema at a time. If necessary, i.e. if it really helps
         // performance, we could implement some form of std iterator
         for (const auto& action:task.actions) {
-            auto applicable = generator.get_applicable_actions(action, state);
+            if (stubborn_sets and !stubborn_sets->is_stubborn(action)) continue;
+            vector<LiftedOperatorId> applicable;
+            if (stubborn_sets) {
+                applicable = move(stubborn_sets->get_applicable_actions(action));
+            }
+            else if constexpr (is_extensional<PackedStateT>) {
+                // Ground schemas are checked with the precondition masks of the packer
+                if (!action.is_ground())
+                    applicable = generator.get_applicable_actions(action, state);
+                else if (packer.is_ground_action_applicable(action, packed_state))
+                    applicable.emplace_back(action.get_index(), vector<int>());
+            }
+            else {
+                applicable = generator.get_applicable_actions(action, state);
+            }
             statistics.inc_generated(applicable.size());
 
             for (const LiftedOperatorId& op_id:applicable) {
-                DBState s = generator.generate_successor(op_id, action, state);
-
                 int dist = g + action.get_cost();
-                int new_h = heuristic.compute_heuristic(s, task);
-                statistics.inc_evaluations();
-                if (new_h == UNSOLVABLE_STATE) {
-                    statistics.inc_dead_ends();
-                    statistics.inc_pruned_states();
-                    continue;
-                }
-
-                auto& child_node = space.insert_or_get_previous_node(packer.pack(s), op_id, node.state_id);
-                if (child_node.status == SearchNode::Status::NEW) {
-                    // Inserted for the first time in the map
-                    child_node.open(dist, new_h);
-                    statistics.inc_evaluated_states();
-                    queue.do_insertion(child_node.state_id, make_pair(new_h, dist));
-                }
-                else {
-                    if (dist < child_node.g) {
-                        child_node.open(dist, new_h); // Reopening
-                        statistics.inc_reopened();
+                auto insert_child = [&](PackedStateT &&child, int new_h) {
+                    auto& child_node = space.insert_or_get_previous_node(move(child), op_id, node.state_id);
+                    if (child_node.status == SearchNode::Status::NEW) {
+                        // Inserted for the first time in the map
+                        child_node.open(dist, new_h);
+                        statistics.inc_evaluated_states();
                         queue.do_insertion(child_node.state_id, make_pair(new_h, dist));
                     }
+                    else {
+                        if (dist < child_node.g) {
+                            child_node.open(dist, new_h); // Reopening
+                            statistics.inc_reopened();
+                            queue.do_insertion(child_node.state_id, make_pair(new_h, dist));
+                        }
+                    }
+                };
+
+                if constexpr (is_extensional<PackedStateT>) {
+                    if (heuristic.supports_extensional_states()) {
+                        // Neither the successor nor the heuristic need an unpacked state
+                        PackedStateT child = packer.generate_successor(op_id, action, packed_state);
+                        int new_h = heuristic.compute_heuristic_packed(child, packer);
+                        if (!is_dead_end(new_h))
+                            insert_child(move(child), new_h);
+                        continue;
+                    }
                 }
+
+                DBState s = generator.generate_successor(op_id, action, state);
+                int new_h = heuristic.compute_heuristic(s, task);
+                if (!is_dead_end(new_h))
+                    insert_child(packer.pack(s), new_h);
             }
         }
     }
@@ -117,6 +192,7 @@ template <class PackedStateT>
 void GreedyBestFirstSearch<PackedStateT>::print_statistics() const {
     statistics.print_detailed_statistics();
     space.print_statistics();
+    if (stubborn_sets) stubborn_sets->print_statistics();
 }
 
 // explicit template instantiations
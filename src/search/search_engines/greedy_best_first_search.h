@@ -5,16 +5,27 @@
 #include "search.h"
 #include "search_space.h"
 
+#include "../pruning/stubborn_sets.h"
+
+#include <memory>
+
 template <class PackedStateT>
 class GreedyBestFirstSearch : public SearchBase {
 protected:
     SearchSpace<PackedStateT> space;
 
+    bool use_stubborn_sets;
+    std::unique_ptr<StubbornSets> stubborn_sets;
+
     int heuristic_layer{};
 public:
+    explicit GreedyBestFirstSearch(bool use_stubborn_sets = false) :
+        use_stubborn_sets(use_stubborn_sets) {}
+
     using StatePackerT = typename PackedStateT::StatePackerT;
 
-    utils::ExitCode search(const Task &task, SuccessorGenerator &generator, Heuristic &heuristic) override;
+    utils::ExitCode search(const Task &task, SuccessorGenerator &generator, Heuristic &heuristic,
+                           utils::Budget &budget) override;
 
     void print_statistics() const override;
 };
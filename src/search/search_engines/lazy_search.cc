@@ -23,7 +23,8 @@ using namespace std;
 template <class PackedStateT>
 utils::ExitCode LazySearch<PackedStateT>::search(const Task &task,
                                                             SuccessorGenerator &generator,
-                                                            Heuristic &heuristic)
+                                                            Heuristic &heuristic,
+                                                            utils::Budget &budget)
 {
     cout << "Starting greedy best first search" << endl;
     clock_t timer_start = clock();
@@ -35,6 +36,9 @@ utils::ExitCode LazySearch<PackedStateT>::search(const Task &task,
     //cout << "@ Initial state: \n\t";
     //task.dump_state(task.initial_state);
 
+    if (use_orbit_search) setup_orbit_search(task, space);
+    setup_invariant_dead_ends(task);
+
     SearchNode& root_node = space.insert_or_get_previous_node(packer.pack(task.initial_state), LiftedOperatorId::no_operator, StateID::no_state);
     heuristic_layer = heuristic.compute_heuristic(task.initial_state, task);
     root_node.open(0, heuristic_layer);
@@ -50,6 +54,7 @@ utils::ExitCode LazySearch<PackedStateT>::search(const Task &task,
     if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
 
     while ((not regular_open_list.empty()) or (not preferred_open_list.empty())) {
+        if (budget.is_exhausted()) return budget_exhausted(budget, timer_start);
         StateID sid = get_top_node(preferred_open_list, regular_open_list); //regular_open_list.remove_min();
         SearchNode &node = space.get_node(sid);
         DBState state = packer.unpack(space.get_state(sid));
@@ -57,6 +62,10 @@ utils::ExitCode LazySearch<PackedStateT>::search(const Task &task,
             continue;
         }
         node.close();
+        if (is_invariant_dead_end(state)) {
+            node.mark_as_unsolvable();
+            continue;
+        }
         int h = heuristic.compute_heuristic(state, task);
         statistics.inc_evaluations();
         statistics.inc_evaluated_states();
@@ -70,6 +79,8 @@ utils::ExitCode LazySearch<PackedStateT>::search(const Task &task,
         node.update_h(h);
         statistics.report_f_value_progress(h); // In GBFS f = h.
         statistics.inc_expanded();
+        if (is_telemetry_due(g, h))
+            emit_telemetry(space.size(), preferred_open_list.size() + regular_open_list.size());
 
         if (h < heuristic_layer) {
             heuristic_layer = h;
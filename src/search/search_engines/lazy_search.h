@@ -33,7 +33,8 @@ public:
 
     using StatePackerT = typename PackedStateT::StatePackerT;
 
-    utils::ExitCode search(const Task &task, SuccessorGenerator &generator, Heuristic &heuristic) override;
+    utils::ExitCode search(const Task &task, SuccessorGenerator &generator, Heuristic &heuristic,
+                           utils::Budget &budget) override;
 
     void print_statistics() const override;
 
@@ -0,0 +1,137 @@
+#include "plan_postprocessing.h"
+
+#include "../action.h"
+#include "../task.h"
+
+#include "../database/table.h"
+#include "../states/state.h"
+#include "../successor_generators/generic_join_successor.h"
+#include "../utils/system.h"
+
+#include <iostream>
+#include <unordered_map>
+
+using namespace std;
+
+struct DBStateHash {
+    size_t operator()(const DBState &state) const {
+        return hash_value(state);
+    }
+};
+
+static int compute_cost(const vector<LiftedOperatorId> &plan, const Task &task) {
+    int cost = 0;
+    for (const LiftedOperatorId &op : plan)
+        cost += task.actions[op.get_index()].get_cost();
+    return cost;
+}
+
+PlanPostprocessor::PlanPostprocessor(const Task &task)
+    : task(task), generator(make_unique<GenericJoinSuccessor>(task)) {}
+
+PlanPostprocessor::~PlanPostprocessor() = default;
+
+bool PlanPostprocessor::is_applicable(const LiftedOperatorId &op, const DBState &state) const {
+    const ActionSchema &action = task.actions[op.get_index()];
+    const auto &nullary_atoms = state.get_nullary_atoms();
+    for (size_t i = 0; i < nullary_atoms.size(); ++i) {
+        if ((action.get_positive_nullary_precond()[i] and !nullary_atoms[i]) or
+            (action.get_negative_nullary_precond()[i] and nullary_atoms[i]))
+            return false;
+    }
+
+    for (const Atom &precond : action.get_precondition()) {
+        GroundAtom tuple;
+        for (const Argument &arg : precond.arguments)
+            tuple.push_back(arg.constant ? arg.index : op.get_instantiation()[arg.index]);
+        if (precond.name == "=") {
+            if ((tuple[0] == tuple[1]) == precond.negated)
+                return false;
+            continue;
+        }
+        const DBState &relations = task.predicates[precond.predicate_symbol].isStaticPredicate()
+                                   ? task.get_static_info() : state;
+        bool holds = relations.get_tuples_of_relation(precond.predicate_symbol).count(tuple) > 0;
+        if (holds == precond.negated)
+            return false;
+    }
+    return true;
+}
+
+vector<DBState> PlanPostprocessor::replay(const vector<LiftedOperatorId> &plan) {
+    vector<DBState> states = {task.initial_state};
+    for (const LiftedOperatorId &op : plan) {
+        if (!is_applicable(op, states.back()))
+            break;
+        states.push_back(generator->generate_successor(op, task.actions[op.get_index()], states.back()));
+    }
+    return states;
+}
+
+vector<LiftedOperatorId> PlanPostprocessor::remove_state_loops(const vector<LiftedOperatorId> &plan,
+                                                               const vector<DBState> &states) const {
+    // Continue from the last visit of every state
+    unordered_map<DBState, size_t, DBStateHash> last_visit;
+    for (size_t i = 0; i < states.size(); ++i)
+        last_visit[states[i]] = i;
+
+    vector<LiftedOperatorId> result;
+    size_t i = 0;
+    while (i < plan.size()) {
+        i = last_visit.at(states[i]);
+        if (i == plan.size())
+            break;
+        result.push_back(plan[i++]);
+    }
+    return result;
+}
+
+void PlanPostprocessor::eliminate_actions(vector<LiftedOperatorId> &plan, vector<DBState> &states) {
+    size_t i = 0;
+    while (i < plan.size()) {
+        // Remove action i and every later action that is no longer applicable
+        vector<LiftedOperatorId> suffix;
+        vector<DBState> suffix_states;
+        DBState state = states[i];
+        for (size_t j = i + 1; j < plan.size(); ++j) {
+            if (!is_applicable(plan[j], state))
+                continue;
+            state = generator->generate_successor(plan[j], task.actions[plan[j].get_index()], state);
+            suffix.push_back(plan[j]);
+            suffix_states.push_back(state);
+        }
+        if (!task.is_goal(state)) {
+            ++i;
+            continue;
+        }
+        // The states up to i are unchanged, try the action that is now at position i
+        plan.erase(plan.begin() + i, plan.end());
+        plan.insert(plan.end(), suffix.begin(), suffix.end());
+        states.erase(states.begin() + i + 1, states.end());
+        states.insert(states.end(), suffix_states.begin(), suffix_states.end());
+    }
+}
+
+vector<LiftedOperatorId> PlanPostprocessor::postprocess(const vector<LiftedOperatorId> &plan) {
+    vector<DBState> states = replay(plan);
+    if (states.size() <= plan.size()) {
+        const LiftedOperatorId &op = plan[states.size() - 1];
+        cerr << "Invalid plan: action " << states.size() << " ("
+             << task.actions[op.get_index()].get_name() << ") is not applicable" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    if (!task.is_goal(states.back())) {
+        cerr << "Invalid plan: the goal is not reached" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+
+    vector<LiftedOperatorId> result = remove_state_loops(plan, states);
+    size_t without_loops = result.size();
+    states = replay(result);
+    eliminate_actions(result, states);
+
+    cout << "Plan post-processing: " << plan.size() - without_loops << " action(s) in state loops, "
+         << without_loops - result.size() << " by action elimination, cost "
+         << compute_cost(plan, task) << " -> " << compute_cost(result, task) << endl;
+    return result;
+}
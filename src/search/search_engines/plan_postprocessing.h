@@ -0,0 +1,47 @@
+#ifndef SEARCH_PLAN_POSTPROCESSING_H
+#define SEARCH_PLAN_POSTPROCESSING_H
+
+#include <memory>
+#include <vector>
+
+class DBState;
+class GenericJoinSuccessor;
+class LiftedOperatorId;
+class Task;
+
+/**
+ * Validates a plan and removes redundant actions from it, for the plans of the
+ * search engines and of the SAT planner alike.
+ *
+ * @details The plan is replayed from the initial state with the generic join
+ * successor generator. Then, subsequences that lead back to an already visited
+ * state are cut, and action elimination removes every action whose removal,
+ * together with the actions that become inapplicable without it, still leads
+ * to a goal state (Nakhost and Müller, 2010).
+ */
+class PlanPostprocessor {
+    const Task &task;
+    std::unique_ptr<GenericJoinSuccessor> generator;
+
+    bool is_applicable(const LiftedOperatorId &op, const DBState &state) const;
+
+    //! The states visited by the plan, up to its first inapplicable action
+    std::vector<DBState> replay(const std::vector<LiftedOperatorId> &plan);
+
+    std::vector<LiftedOperatorId> remove_state_loops(const std::vector<LiftedOperatorId> &plan,
+                                                     const std::vector<DBState> &states) const;
+
+    void eliminate_actions(std::vector<LiftedOperatorId> &plan, std::vector<DBState> &states);
+
+public:
+    explicit PlanPostprocessor(const Task &task);
+    ~PlanPostprocessor();
+
+    /**
+     * Return the plan without redundant actions. If the plan is not applicable
+     * or does not reach the goal, the planner stops with a critical error.
+     */
+    std::vector<LiftedOperatorId> postprocess(const std::vector<LiftedOperatorId> &plan);
+};
+
+#endif //SEARCH_PLAN_POSTPROCESSING_H
@@ -2,12 +2,22 @@
 #include "search.h"
 #include "search_space.h"
 #include "utils.h"
+#include "../invariants.h"
 #include "../task.h"
+#include "../pruning/object_symmetries.h"
 #include "../states/sparse_states.h"
 #include "../states/extensional_states.h"
 
+#include <memory>
+
 using namespace std;
 
+utils::ExitCode SearchBase::budget_exhausted(const utils::Budget &budget, clock_t timer_start) {
+    budget.print_exhausted();
+    print_no_solution_found(timer_start);
+    return budget.get_exit_code();
+}
+
 bool SearchBase::is_useful_operator(const Task &task, const DBState &state,
                                     const map<int, std::vector<GroundAtom>> &useful_atoms,
                                     const vector<bool> &useful_nullary_atoms) {
@@ -29,6 +39,22 @@ bool SearchBase::is_useful_operator(const Task &task, const DBState &state,
     return false;
 }
 
+void SearchBase::setup_invariant_dead_ends(const Task &task) {
+    if (task.invariants.empty())
+        return;
+    auto dead_ends = make_shared<InvariantDeadEnds>(task);
+    if (!dead_ends->empty())
+        invariant_dead_ends = move(dead_ends);
+}
+
+bool SearchBase::is_invariant_dead_end(const DBState &state) {
+    if (!invariant_dead_ends or !invariant_dead_ends->is_dead_end(state))
+        return false;
+    statistics.inc_dead_ends();
+    statistics.inc_pruned_states();
+    return true;
+}
+
 template<class PackedStateT>
 bool SearchBase::check_goal(const Task &task,
                        const SuccessorGenerator &generator,
@@ -44,6 +70,21 @@ bool SearchBase::check_goal(const Task &task,
     return true;
 }
 
+bool SearchBase::check_goal(const Task &task,
+                            const ExtensionalStatePacker &packer,
+                            const SuccessorGenerator &generator,
+                            clock_t timer_start,
+                            const ExtensionalPackedState &state,
+                            const SearchNode &node,
+                            const SearchSpace<ExtensionalPackedState> &space) const {
+    if (!packer.is_goal(state)) return false;
+
+    print_goal_found(generator, timer_start);
+    auto plan = space.extract_plan(node);
+    print_plan(plan, task);
+    return true;
+}
+
 // explicit instantiations
 template bool SearchBase::check_goal<SparsePackedState>(
         const Task &task, const SuccessorGenerator &generator, clock_t timer_start,
@@ -53,3 +94,24 @@ template bool SearchBase::check_goal<ExtensionalPackedState>(
         const Task &task, const SuccessorGenerator &generator, clock_t timer_start,
         const DBState &state, const SearchNode &node, const SearchSpace<ExtensionalPackedState> &space) const;
 
+
+template<>
+void SearchBase::setup_orbit_search<SparsePackedState>(const Task &task,
+                                                       SearchSpace<SparsePackedState> &space) const {
+    auto symmetries = make_shared<ObjectSymmetries>(task);
+    symmetries->print_statistics();
+    if (symmetries->empty()) {
+        cout << "No object symmetries found, orbit search disabled" << endl;
+        return;
+    }
+    space.enable_orbit_mode([symmetries](const SparsePackedState &state) {
+        return symmetries->canonical_state(state);
+    });
+}
+
+template<>
+void SearchBase::setup_orbit_search<ExtensionalPackedState>(const Task &,
+                                                            SearchSpace<ExtensionalPackedState> &) const {
+    cerr << "Orbit search is only supported with the sparse state representation" << endl;
+    exit(-1);
+}
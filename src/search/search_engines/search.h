@@ -2,12 +2,17 @@
 #define SEARCH_SEARCH_H
 
 #include "../search_statistics.h"
+#include "../search_telemetry.h"
 #include "../structures.h"
+#include "../utils/budget.h"
 #include "../utils/system.h"
 
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
-#include <map>
 
 // Forward declarations
 class SuccessorGenerator;
@@ -15,19 +20,56 @@ class Heuristic;
 class Task;
 class DBState;
 class SearchNode;
+class SparsePackedState;
+class ExtensionalPackedState;
+class ExtensionalStatePacker;
+class InvariantDeadEnds;
 template <typename StateT> class SearchSpace;
 
+/*
+ * Extensional states can be expanded and goal-tested directly on the packed
+ * bitset (see ExtensionalStatePacker).
+ */
+template <class PackedStateT>
+constexpr bool is_extensional = std::is_same<PackedStateT, ExtensionalPackedState>::value;
+
 class SearchBase {
 public:
     SearchBase() = default;
     virtual ~SearchBase() = default;
 
+    /*
+     * Search for a plan until the budget is exhausted. Engines check the budget in their
+     * main loops and return its exit code when it expires.
+     */
     virtual utils::ExitCode search(const Task &task,
                        SuccessorGenerator &generator,
-                       Heuristic &heuristic) = 0;
+                       Heuristic &heuristic,
+                       utils::Budget &budget) = 0;
 
     virtual void print_statistics() const = 0;
 
+    //! Detect duplicates up to object symmetries (sparse states only)
+    void set_orbit_search(bool orbit_search) {
+        use_orbit_search = orbit_search;
+    }
+
+    /*
+     * Save a checkpoint of the search to the given file every interval seconds, and
+     * resume from the last checkpoint of the file if resume is true (bfs and gbfs only,
+     * see Checkpoint).
+     */
+    void set_checkpoint(const std::string &file, double interval, bool resume) {
+        checkpoint_file = file;
+        checkpoint_interval = interval;
+        resume_from_checkpoint = resume;
+    }
+
+    //! Write progress records to the given file (see SearchTelemetry)
+    void set_telemetry(const std::string &file, std::int64_t expansions, double seconds) {
+        telemetry = std::make_unique<SearchTelemetry>(file, expansions, seconds);
+    }
+
     template <class PackedStateT>
     bool check_goal(const Task &task,
                     const SuccessorGenerator &generator,
@@ -36,10 +78,49 @@ public:
                     const SearchNode &node,
                     const SearchSpace<PackedStateT> &space) const;
 
+    //! Goal test directly on the packed state, using the goal masks of the packer
+    bool check_goal(const Task &task,
+                    const ExtensionalStatePacker &packer,
+                    const SuccessorGenerator &generator,
+                    clock_t timer_start,
+                    const ExtensionalPackedState &state,
+                    const SearchNode &node,
+                    const SearchSpace<ExtensionalPackedState> &space) const;
+
 protected:
 
     SearchStatistics statistics;
 
+    bool use_orbit_search = false;
+
+    std::string checkpoint_file;
+    double checkpoint_interval = 0;
+    bool resume_from_checkpoint = false;
+
+    std::unique_ptr<SearchTelemetry> telemetry;
+
+    //! Record the g and h values of an expanded state, return true if a telemetry record is due
+    bool is_telemetry_due(int g, int h) {
+        return telemetry and telemetry->record_expansion(g, h);
+    }
+
+    void emit_telemetry(std::size_t registered_states, std::size_t open_list_size) {
+        telemetry->emit(statistics, registered_states, open_list_size);
+    }
+
+    std::shared_ptr<InvariantDeadEnds> invariant_dead_ends;
+
+    template <class PackedStateT>
+    void setup_orbit_search(const Task &task, SearchSpace<PackedStateT> &space) const;
+
+    //! Report the exhausted budget and return its exit code
+    static utils::ExitCode budget_exhausted(const utils::Budget &budget, clock_t timer_start);
+
+    //! Detect dead ends with the invariants of the task, if it has any
+    void setup_invariant_dead_ends(const Task &task);
+
+    //! Return true (and count the state as pruned) if the state is an invariant dead end
+    bool is_invariant_dead_end(const DBState &state);
 
     static bool is_useful_operator(
         const Task &task,
@@ -49,4 +130,12 @@ protected:
 
 };
 
+template <>
+void SearchBase::setup_orbit_search<SparsePackedState>(
+    const Task &task, SearchSpace<SparsePackedState> &space) const;
+
+template <>
+void SearchBase::setup_orbit_search<ExtensionalPackedState>(
+    const Task &task, SearchSpace<ExtensionalPackedState> &space) const;
+
 #endif //SEARCH_SEARCH_H
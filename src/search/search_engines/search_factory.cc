@@ -1,20 +1,66 @@
 
 #include "search_factory.h"
 
+#include "alternation_search.h"
+#include "beam_search.h"
 #include "breadth_first_search.h"
+#include "enforced_hill_climbing_search.h"
 #include "greedy_best_first_search.h"
 #include "lazy_search.h"
 #include "search.h"
 
+#include "../options.h"
+#include "../heuristics/heuristic_factory.h"
 #include "../states/extensional_states.h"
 #include "../states/sparse_states.h"
 
 #include <boost/algorithm/string.hpp>
 
 SearchBase*
-SearchFactory::create(const std::string& method, const std::string& state_type) {
+SearchFactory::create(const Options &opt, const Task &task) {
+    const std::string &method = opt.get_search_engine();
     std::cout << "Creating search factory for method " << method << "..." << std::endl;
-    bool using_ext_state = boost::iequals(state_type, "extensional");
+    bool using_ext_state = boost::iequals(opt.get_state_representation(), "extensional");
+    bool stubborn_sets = opt.get_stubborn_sets();
+    bool orbit_search = opt.get_orbit_search();
+
+    if (stubborn_sets and !boost::iequals(method, "bfs") and !boost::iequals(method, "gbfs")) {
+        std::cerr << "Stubborn sets are only supported by bfs and gbfs" << std::endl;
+        exit(-1);
+    }
+    if (orbit_search and using_ext_state) {
+        std::cerr << "Orbit search is only supported with the sparse state representation" << std::endl;
+        exit(-1);
+    }
+    if (orbit_search and (boost::istarts_with(method, "ehc") or boost::iequals(method, "beam"))) {
+        std::cerr << "Orbit search is not supported by ehc and beam" << std::endl;
+        exit(-1);
+    }
+    if (orbit_search and stubborn_sets) {
+        std::cerr << "Orbit search cannot be combined with stubborn sets" << std::endl;
+        exit(-1);
+    }
+    const std::string &checkpoint_file = opt.get_checkpoint_file();
+    if (opt.get_resume() and checkpoint_file.empty()) {
+        std::cerr << "Resuming requires a checkpoint file" << std::endl;
+        exit(-1);
+    }
+    if (!checkpoint_file.empty()) {
+        if (!boost::iequals(method, "bfs") and !boost::iequals(method, "gbfs")) {
+            std::cerr << "Checkpoints are only supported by bfs and gbfs" << std::endl;
+            exit(-1);
+        }
+        if (orbit_search) {
+            std::cerr << "Checkpoints cannot be combined with orbit search" << std::endl;
+            exit(-1);
+        }
+        if (opt.get_checkpoint_interval() <= 0) {
+            std::cerr << "Checkpoint interval must be positive" << std::endl;
+            exit(-1);
+        }
+    }
+
+    SearchBase *engine;
 
     if (boost::iequals(method, "naive")) {
         std::cerr << "WARNING: The \"naive\" keyword for search engines "
@@ -22,28 +68,84 @@ SearchFactory::create(const std::string& method, const std::string& state_type)
         exit(-1);
     }
     else if (boost::iequals(method, "bfs")) {
-        if (using_ext_state) return new BreadthFirstSearch<ExtensionalPackedState>();
-        else return new BreadthFirstSearch<SparsePackedState>();
+        if (using_ext_state) engine = new BreadthFirstSearch<ExtensionalPackedState>(stubborn_sets);
+        else engine = new BreadthFirstSearch<SparsePackedState>(stubborn_sets);
     }
 
     else if (boost::iequals(method, "gbfs")) {
-        if (using_ext_state) return new GreedyBestFirstSearch<ExtensionalPackedState>();
-        else return new GreedyBestFirstSearch<SparsePackedState>();
+        if (using_ext_state) engine = new GreedyBestFirstSearch<ExtensionalPackedState>(stubborn_sets);
+        else engine = new GreedyBestFirstSearch<SparsePackedState>(stubborn_sets);
     }
     else if (boost::iequals(method, "lazy")) {
-        if (using_ext_state) return new LazySearch<ExtensionalPackedState>(true, false);
-        else return new LazySearch<SparsePackedState>(true, false);
+        if (using_ext_state) engine = new LazySearch<ExtensionalPackedState>(true, false);
+        else engine = new LazySearch<SparsePackedState>(true, false);
     }
     else if (boost::iequals(method, "lazy-po")) {
-        if (using_ext_state) return new LazySearch<ExtensionalPackedState>(false, false);
-        else return new LazySearch<SparsePackedState>(false, false);
+        if (using_ext_state) engine = new LazySearch<ExtensionalPackedState>(false, false);
+        else engine = new LazySearch<SparsePackedState>(false, false);
     }
     else if (boost::iequals(method, "lazy-prune")) {
-        if (using_ext_state) return new LazySearch<ExtensionalPackedState>(false, true);
-        else return new LazySearch<SparsePackedState>(false, true);
+        if (using_ext_state) engine = new LazySearch<ExtensionalPackedState>(false, true);
+        else engine = new LazySearch<SparsePackedState>(false, true);
+    }
+    else if (boost::iequals(method, "alt") or boost::iequals(method, "alt-po")) {
+        // Additional heuristics alternating with the one given by the evaluator option
+        std::vector<std::string> names;
+        boost::split(names, opt.get_alternation_heuristics(), boost::is_any_of(","));
+        // The Datalog heuristics share global fact indices, so only one of them can be used
+        auto is_datalog = [](const std::string &name) {
+            return boost::iequals(name, "add") or boost::iequals(name, "hmax");
+        };
+        int datalog_heuristics = is_datalog(opt.get_evaluator());
+        for (const std::string &name : names)
+            datalog_heuristics += is_datalog(name);
+        if (datalog_heuristics > 1) {
+            std::cerr << "At most one of the heuristics add and hmax can be used at the same time" << std::endl;
+            exit(-1);
+        }
+        auto create_extra_heuristics = [&]() {
+            std::vector<std::unique_ptr<Heuristic>> heuristics;
+            for (const std::string &name : names) {
+                if (!name.empty())
+                    heuristics.emplace_back(HeuristicFactory::create(name, opt, task));
+            }
+            return heuristics;
+        };
+        bool preferred = boost::iequals(method, "alt-po");
+        bool lazy_evaluation = opt.get_lazy_evaluation();
+        if (using_ext_state) engine = new AlternationSearch<ExtensionalPackedState>(create_extra_heuristics(), preferred, lazy_evaluation);
+        else engine = new AlternationSearch<SparsePackedState>(create_extra_heuristics(), preferred, lazy_evaluation);
+    }
+    else if (boost::iequals(method, "ehc")) {
+        if (using_ext_state) engine = new EnforcedHillClimbingSearch<ExtensionalPackedState>(false);
+        else engine = new EnforcedHillClimbingSearch<SparsePackedState>(false);
+    }
+    else if (boost::iequals(method, "ehc-prune")) {
+        if (using_ext_state) engine = new EnforcedHillClimbingSearch<ExtensionalPackedState>(true);
+        else engine = new EnforcedHillClimbingSearch<SparsePackedState>(true);
+    }
+    else if (boost::iequals(method, "beam")) {
+        int width = opt.get_beam_width();
+        if (width < 1) {
+            std::cerr << "Beam width must be positive" << std::endl;
+            exit(-1);
+        }
+        if (using_ext_state) engine = new BeamSearch<ExtensionalPackedState>(width);
+        else engine = new BeamSearch<SparsePackedState>(width);
     }
     else {
         std::cerr << "Invalid search method \"" << method << "\"" << std::endl;
         exit(-1);
     }
+
+    engine->set_orbit_search(orbit_search);
+    engine->set_checkpoint(checkpoint_file, opt.get_checkpoint_interval(), opt.get_resume());
+    if (!opt.get_telemetry_file().empty()) {
+        if (opt.get_telemetry_interval() <= 0 and opt.get_telemetry_expansions() <= 0) {
+            std::cerr << "Telemetry requires a positive interval or number of expansions" << std::endl;
+            exit(-1);
+        }
+        engine->set_telemetry(opt.get_telemetry_file(), opt.get_telemetry_expansions(), opt.get_telemetry_interval());
+    }
+    return engine;
 }
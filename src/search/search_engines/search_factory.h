@@ -3,11 +3,13 @@
 
 #include <string>
 
+class Options;
 class SearchBase;
+class Task;
 
 class SearchFactory {
 public:
-    static SearchBase*create(const std::string& method, const std::string& state_type);
+    static SearchBase*create(const Options &opt, const Task &task);
 };
 
 #endif //SEARCH_SEARCH_FACTORY_H
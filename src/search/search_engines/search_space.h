@@ -6,6 +6,7 @@
 #include "nodes.h"
 
 #include <fstream>
+#include <functional>
 #include <unordered_set>
 
 class LiftedOperatorId;
@@ -48,6 +49,15 @@ protected:
     segmented_vector::SegmentedVector<SearchNode> node_data;
     StateIDSet registered_states;
 
+    /*
+     * In orbit mode, 'state_data' holds the canonical representatives used to detect
+     * duplicates, and 'orbit_state_data' the first state reached of each orbit. The
+     * latter is the one expanded, so the operators stored in the nodes always lead
+     * from the parent state to the state of the node and plans can be extracted as usual.
+     */
+    std::function<StateT(const StateT&)> canonical_representative;
+    segmented_vector::SegmentedVector<StateT> orbit_state_data;
+
 public:
     SearchSpace() :
             state_data(),
@@ -63,13 +73,27 @@ public:
 //        return StateID(state_data.size()-1);
 //    }
 
+    //! Register states by the canonical representative of their orbit. Must be called
+    //! before inserting any state.
+    void enable_orbit_mode(std::function<StateT(const StateT&)> canonical) {
+        assert(state_data.size() == 0);
+        canonical_representative = std::move(canonical);
+    }
+
+    bool in_orbit_mode() const { return bool(canonical_representative); }
+
     SearchNode& insert_or_get_previous_node(StateT&& state, const LiftedOperatorId& op, StateID parent) {
         int id = state_data.size();
-        state_data.push_back(std::move(state));
+        if (in_orbit_mode())
+            state_data.push_back(canonical_representative(state));
+        else
+            state_data.push_back(std::move(state));
         auto result = registered_states.insert(id);
 
         if (result.second) { // It's an unseen state, create the node
             node_data.push_back(SearchNode(StateID(id), op, parent, 0));
+            if (in_orbit_mode())
+                orbit_state_data.push_back(std::move(state));
 
         } else { // The state was already registered
             id = result.first;
@@ -97,13 +121,26 @@ public:
         return plan;
     }
 
+    //! Return the node of the index-th registered state
+    SearchNode &node_at(std::size_t index) {
+        assert(index < node_data.size());
+        return node_data[index];
+    }
+
+    const SearchNode &node_at(std::size_t index) const {
+        assert(index < node_data.size());
+        return node_data[index];
+    }
+
     SearchNode &get_node(StateID id) {
         assert(id.value >= 0 && (unsigned) id.value < node_data.size());
         return node_data[id.value];
     }
 
-    const StateT& get_state(StateID id) {
+    const StateT& get_state(StateID id) const {
         assert(id.value >= 0 && (unsigned) id.value < state_data.size());
+        if (in_orbit_mode())
+            return orbit_state_data[id.value];
         return state_data[id.value];
     }
 
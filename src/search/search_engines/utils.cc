@@ -1,5 +1,6 @@
 
 #include "utils.h"
+#include "plan_postprocessing.h"
 #include "../action.h"
 #include "../successor_generators/successor_generator.h"
 #include "../states/sparse_states.h"
@@ -8,11 +9,18 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
 using namespace std;
 
+static unique_ptr<PlanPostprocessor> plan_postprocessor;
+
+void enable_plan_postprocessing(const Task &task) {
+    plan_postprocessor = make_unique<PlanPostprocessor>(task);
+}
+
 void print_no_solution_found(const clock_t& timer_start) {
     cerr << "No solution found!" << endl;
     cout << "Total time: " << double(clock() - timer_start) / CLOCKS_PER_SEC << endl;
@@ -46,7 +54,9 @@ void extract_plan(
 }
 
 
-void print_plan(const std::vector<LiftedOperatorId>& plan, const Task &task) {
+void print_plan(const std::vector<LiftedOperatorId>& original_plan, const Task &task) {
+    const std::vector<LiftedOperatorId> &plan = plan_postprocessor
+        ? plan_postprocessor->postprocess(original_plan) : original_plan;
     int total_plan_cost = 0;
     int total_plan_length = 0;
     std::ofstream plan_file("sas_plan");
@@ -31,4 +31,11 @@ void extract_plan(
     const SparseStatePacker &packer,
     const Task &task);
 
+/**
+ * Validate and shorten every plan before print_plan writes it.
+ *
+ * @see PlanPostprocessor (plan_postprocessing.h)
+ */
+void enable_plan_postprocessing(const Task &task);
+
 void print_plan(const std::vector<LiftedOperatorId>& plan, const Task &task);
@@ -1,5 +1,6 @@
 #include "search_statistics.h"
 
+#include "utils/binary_io.h"
 #include "utils/logging.h"
 #include "utils/timer.h"
 #include "utils/system.h"
@@ -59,6 +60,26 @@ void SearchStatistics::print_checkpoint_line(int g) const {
     }
 }
 
+void SearchStatistics::save(ostream &out) const {
+    for (int64_t counter : {expanded_states, evaluated_states, evaluations, generated_states,
+                            reopened_states, dead_end_states, pruned_states, generated_ops,
+                            lastjump_expanded_states, lastjump_reopened_states,
+                            lastjump_evaluated_states, lastjump_generated_states}) {
+        utils::write_binary<int64_t>(out, counter);
+    }
+    utils::write_binary<int64_t>(out, lastjump_value);
+}
+
+void SearchStatistics::load(istream &in) {
+    for (int64_t *counter : {&expanded_states, &evaluated_states, &evaluations, &generated_states,
+                             &reopened_states, &dead_end_states, &pruned_states, &generated_ops,
+                             &lastjump_expanded_states, &lastjump_reopened_states,
+                             &lastjump_evaluated_states, &lastjump_generated_states}) {
+        *counter = utils::read_binary<int64_t>(in);
+    }
+    lastjump_value = utils::read_binary<int64_t>(in);
+}
+
 void SearchStatistics::print_basic_statistics() const {
     cout << evaluated_states << " evaluated, "
          << expanded_states << " expanded, "
@@ -0,0 +1,71 @@
+#include "search_telemetry.h"
+
+#include "search_statistics.h"
+
+#include "utils/system.h"
+
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+SearchTelemetry::SearchTelemetry(const string &filename, int64_t expansions, double seconds)
+    : out(filename),
+      expansions_interval(expansions),
+      time_interval(chrono::duration_cast<chrono::steady_clock::duration>(
+          chrono::duration<double>(seconds))),
+      start_time(chrono::steady_clock::now()),
+      last_record_time(start_time),
+      last_expanded(0),
+      last_generated(0),
+      last_evaluations(0),
+      calls_since_clock_check(0),
+      records(0)
+{
+    if (!out) {
+        cerr << "Error opening telemetry file " << filename << endl;
+        exit(-1);
+    }
+    reset_ranges();
+}
+
+void SearchTelemetry::reset_ranges() {
+    expansions_since_record = 0;
+    min_g = min_h = numeric_limits<int>::max();
+    max_g = max_h = numeric_limits<int>::min();
+}
+
+void SearchTelemetry::emit(const SearchStatistics &statistics,
+                           size_t registered_states,
+                           size_t open_list_size)
+{
+    auto now = chrono::steady_clock::now();
+    double elapsed = chrono::duration<double>(now - last_record_time).count();
+    auto rate = [elapsed](int64_t current, int64_t last) {
+        return elapsed > 0 ? double(current - last) / elapsed : 0.0;
+    };
+
+    // Every line is a complete JSON object, flushed so that readers see it immediately
+    out << "{\"record\": " << records++
+        << ", \"time\": " << chrono::duration<double>(now - start_time).count()
+        << ", \"expanded\": " << statistics.get_expanded()
+        << ", \"generated\": " << statistics.get_generated()
+        << ", \"evaluations\": " << statistics.get_evaluations()
+        << ", \"expansions_per_second\": " << rate(statistics.get_expanded(), last_expanded)
+        << ", \"generations_per_second\": " << rate(statistics.get_generated(), last_generated)
+        << ", \"evaluations_per_second\": " << rate(statistics.get_evaluations(), last_evaluations)
+        << ", \"registered_states\": " << registered_states
+        << ", \"open_list_size\": " << open_list_size
+        << ", \"peak_memory_kb\": " << utils::get_peak_memory_in_kb();
+    if (expansions_since_record > 0) {
+        out << ", \"min_g\": " << min_g << ", \"max_g\": " << max_g
+            << ", \"min_h\": " << min_h << ", \"max_h\": " << max_h;
+    }
+    out << "}" << endl;
+
+    last_record_time = now;
+    last_expanded = statistics.get_expanded();
+    last_generated = statistics.get_generated();
+    last_evaluations = statistics.get_evaluations();
+    reset_ranges();
+}
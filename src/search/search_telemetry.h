@@ -0,0 +1,65 @@
+#ifndef SEARCH_TELEMETRY_H
+#define SEARCH_TELEMETRY_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+class SearchStatistics;
+
+/*
+  Periodic progress records of a search, written as JSON lines to a file
+  (which can also be a named pipe).
+
+  Engines call record_expansion() for every expanded state and, when it
+  returns true, emit() with the current sizes of their state registry and
+  open list. A record is due every 'expansions' expansions (if positive) and
+  every 'seconds' seconds (if positive); the clock is only read every 256
+  expansions. Each record holds the counters of
+  the statistics, their rates since the previous record, the peak memory
+  usage and the ranges of the g and h values expanded since the previous
+  record.
+*/
+class SearchTelemetry {
+    std::ofstream out;
+    std::int64_t expansions_interval;
+    std::chrono::steady_clock::duration time_interval;
+
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point last_record_time;
+    std::int64_t last_expanded;
+    std::int64_t last_generated;
+    std::int64_t last_evaluations;
+
+    std::int64_t expansions_since_record;
+    int calls_since_clock_check;
+    int min_g, max_g, min_h, max_h;
+    int records;
+
+    void reset_ranges();
+public:
+    SearchTelemetry(const std::string &filename, std::int64_t expansions, double seconds);
+
+    //! Record the g and h values of an expanded state, return true if a record is due
+    bool record_expansion(int g, int h) {
+        ++expansions_since_record;
+        if (g < min_g) min_g = g;
+        if (g > max_g) max_g = g;
+        if (h < min_h) min_h = h;
+        if (h > max_h) max_h = h;
+        if (expansions_interval > 0 and expansions_since_record >= expansions_interval)
+            return true;
+        // Reading the clock at every expansion is too expensive for cheap heuristics
+        if (time_interval.count() <= 0 or ++calls_since_clock_check < 256)
+            return false;
+        calls_since_clock_check = 0;
+        return std::chrono::steady_clock::now() - last_record_time >= time_interval;
+    }
+
+    void emit(const SearchStatistics &statistics,
+              std::size_t registered_states,
+              std::size_t open_list_size);
+};
+
+#endif
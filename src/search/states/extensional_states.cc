@@ -1,5 +1,7 @@
 
 #include "extensional_states.h"
+#include "../action.h"
+#include "../action_schema.h"
 #include "../algorithms/cartesian_iterator.h"
 #include "../task.h"
 #include "../utils.h"
@@ -39,6 +41,11 @@ ExtensionalStatePacker::ExtensionalStatePacker(const Task &task) :
         args_to_index.emplace_back();  // emplace back an empty map
         auto& ati_map = args_to_index.back();
 
+        if (!pred.isRelevant()) { // Never part of any state, see relevance_analysis.h
+            blank_state.set_relation_predicate_symbol(pid, pid);
+            continue;
+        }
+
         const auto& types = pred.getTypes();
         if (types.empty()) { // A nullary predicate - special treatment
             ati_map.emplace(args_t(), index_to_args.size());
@@ -62,6 +69,172 @@ ExtensionalStatePacker::ExtensionalStatePacker(const Task &task) :
     }
 
     std::cout << "Indexed a total of " << num_atoms() << " atoms" << std::endl;
+
+    create_goal_masks();
+    create_ground_action_masks();
+}
+
+int ExtensionalStatePacker::find_index(int predicate, const std::vector<int>& arguments) const {
+    const auto& ati_map = args_to_index[predicate];
+    auto it = ati_map.find(arguments);
+    return (it == ati_map.end()) ? -1 : (int) it->second;
+}
+
+void ExtensionalStatePacker::create_goal_masks() {
+    goal = std::make_unique<LiteralMasks>(num_atoms());
+    unreachable_goals = 0;
+    for (int pred : task.goal.positive_nullary_goals) {
+        goal->positive.set(to_index(pred, {}));
+    }
+    for (int pred : task.goal.negative_nullary_goals) {
+        goal->negative.set(to_index(pred, {}));
+    }
+    for (const AtomicGoal &atomic_goal : task.goal.goal) {
+        int index = find_index(atomic_goal.predicate, atomic_goal.args);
+        if (index == -1) {
+            // Never true: the atom is not type-consistent or its predicate is irrelevant
+            if (!atomic_goal.negated)
+                ++unreachable_goals;
+            continue;
+        }
+        if (atomic_goal.negated)
+            goal->negative.set(index);
+        else
+            goal->positive.set(index);
+    }
+}
+
+void ExtensionalStatePacker::create_ground_action_masks() {
+    const auto& static_info = task.get_static_info();
+    for (const ActionSchema &action : task.actions) {
+        if (!action.is_ground())
+            continue;
+        auto masks = std::make_unique<GroundActionMasks>(num_atoms());
+
+        const auto& positive_nullary = action.get_positive_nullary_precond();
+        const auto& negative_nullary = action.get_negative_nullary_precond();
+        for (std::size_t pid = 0; pid < npreds; ++pid) {
+            if (positive_nullary[pid] or negative_nullary[pid]) {
+                int index = find_index(pid, {});
+                if (index == -1) {
+                    // Irrelevant nullary predicate, always false
+                    masks->statically_applicable &= !positive_nullary[pid];
+                    continue;
+                }
+                (positive_nullary[pid] ? masks->precondition.positive
+                                       : masks->precondition.negative).set(index);
+            }
+        }
+        for (const Atom &precond : action.get_precondition()) {
+            args_t tuple;
+            for (const Argument &arg : precond.arguments) {
+                assert(arg.constant);
+                tuple.push_back(arg.index);
+            }
+            if (precond.name == "=") {
+                masks->statically_applicable &= ((tuple[0] == tuple[1]) != precond.negated);
+                continue;
+            }
+            if (task.predicates[precond.predicate_symbol].isStaticPredicate()) {
+                const auto& tuples = static_info.get_tuples_of_relation(precond.predicate_symbol);
+                bool holds = tuples.find(tuple) != tuples.end();
+                masks->statically_applicable &= (holds != precond.negated);
+                continue;
+            }
+            int index = find_index(precond.predicate_symbol, tuple);
+            if (index == -1) {
+                masks->statically_applicable &= precond.negated;
+                continue;
+            }
+            (precond.negated ? masks->precondition.negative
+                             : masks->precondition.positive).set(index);
+        }
+
+        // Nullary effects are applied first (deletes before adds), then the
+        // remaining effects in order
+        const auto& positive_nullary_effects = action.get_positive_nullary_effects();
+        const auto& negative_nullary_effects = action.get_negative_nullary_effects();
+        for (std::size_t pid = 0; pid < npreds; ++pid) {
+            int index = (positive_nullary_effects[pid] or negative_nullary_effects[pid])
+                        ? find_index(pid, {}) : -1;
+            if (index == -1)
+                continue;
+            if (positive_nullary_effects[pid])
+                masks->add.set(index);
+            else
+                masks->del.set(index);
+        }
+        for (const Atom &eff : action.get_effects()) {
+            args_t tuple;
+            for (const Argument &arg : eff.arguments) {
+                assert(arg.constant);
+                tuple.push_back(arg.index);
+            }
+            int index = find_index(eff.predicate_symbol, tuple);
+            if (index == -1)
+                continue;
+            if (eff.negated) {
+                masks->del.set(index);
+                masks->add.reset(index);
+            }
+            else {
+                masks->add.set(index);
+                masks->del.reset(index);
+            }
+        }
+
+        if ((std::size_t) action.get_index() >= ground_actions.size())
+            ground_actions.resize(action.get_index() + 1);
+        ground_actions[action.get_index()] = std::move(masks);
+    }
+}
+
+bool ExtensionalStatePacker::is_ground_action_applicable(const ActionSchema &action,
+                                                         const ExtensionalPackedState &packed) const {
+    const GroundActionMasks &masks = *ground_actions[action.get_index()];
+    return masks.statically_applicable && masks.precondition.is_satisfied(packed);
+}
+
+ExtensionalPackedState ExtensionalStatePacker::generate_successor(const LiftedOperatorId &op,
+                                                                  const ActionSchema &action,
+                                                                  const ExtensionalPackedState &packed) const {
+    ExtensionalPackedState successor(packed);
+    if (action.is_ground()) {
+        const GroundActionMasks &masks = *ground_actions[action.get_index()];
+        successor.atoms -= masks.del;
+        successor.atoms |= masks.add;
+        return successor;
+    }
+
+    const auto& positive_nullary_effects = action.get_positive_nullary_effects();
+    const auto& negative_nullary_effects = action.get_negative_nullary_effects();
+    for (std::size_t pid = 0; pid < npreds; ++pid) {
+        if (negative_nullary_effects[pid] and !positive_nullary_effects[pid]) {
+            int index = find_index(pid, {});
+            if (index != -1) successor.atoms.reset(index);
+        }
+        else if (positive_nullary_effects[pid]) {
+            int index = find_index(pid, {});
+            if (index != -1) successor.atoms.set(index);
+        }
+    }
+
+    const std::vector<int>& instantiation = op.get_instantiation();
+    args_t tuple;
+    for (const Atom &eff : action.get_effects()) {
+        tuple.clear();
+        for (const Argument &arg : eff.arguments) {
+            tuple.push_back(arg.constant ? arg.index : instantiation[arg.index]);
+        }
+        int index = find_index(eff.predicate_symbol, tuple);
+        if (index == -1)
+            continue;
+        if (eff.negated)
+            successor.atoms.reset(index);
+        else
+            successor.atoms.set(index);
+    }
+    return successor;
 }
 
 unsigned ExtensionalStatePacker::to_index(int predicate, const std::vector<int>& arguments) const {
@@ -4,12 +4,15 @@
 #include "state.h"
 #include "../algorithms/dynamic_bitset.h"
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
 //#include <boost/dynamic_bitset.hpp>
 #include <boost/functional/hash.hpp>
 
+class ActionSchema;
+class LiftedOperatorId;
 class Task;
 
 /**
@@ -47,8 +50,48 @@ public:
 };
 
 
+/**
+ * @brief Conjunction of literals over the atoms indexed by an ExtensionalStatePacker
+ */
+struct LiteralMasks {
+    dynamic_bitset::DynamicBitset<> positive;
+    dynamic_bitset::DynamicBitset<> negative;
+
+    explicit LiteralMasks(std::size_t size) : positive(size), negative(size) {}
+
+    bool is_satisfied(const ExtensionalPackedState &state) const {
+        return positive.is_subset_of(state.atoms) && !negative.intersects(state.atoms);
+    }
+
+    int count_unsatisfied(const ExtensionalPackedState &state) const {
+        return positive.count_difference(state.atoms) + negative.count_intersection(state.atoms);
+    }
+};
+
+/**
+ * @brief Precondition and effects of a ground action schema as bit masks
+ *
+ * @details Static preconditions are checked once when creating the masks. The
+ * effects are applied as (s - del) | add, which is equivalent to applying them
+ * in order as 'del' never contains atoms of 'add'.
+ */
+struct GroundActionMasks {
+    bool statically_applicable;
+    LiteralMasks precondition;
+    dynamic_bitset::DynamicBitset<> add;
+    dynamic_bitset::DynamicBitset<> del;
+
+    explicit GroundActionMasks(std::size_t size)
+        : statically_applicable(true), precondition(size), add(size), del(size) {}
+};
+
+
 /**
  * @brief Pack and unpack states into a more compact representation
+ *
+ * @details The packer also keeps the goal and the ground action schemas as
+ * masks over its atom indexing, so that goal tests, goalcount and ground
+ * actions can be evaluated on packed states with word-parallel operations.
  */
 class ExtensionalStatePacker {
 protected:
@@ -63,6 +106,19 @@ protected:
     //! A state placeholder for faster creation of states in ExtensionalStatePacker::pack
     DBState blank_state;
 
+    std::unique_ptr<LiteralMasks> goal;
+    //! Positive goal atoms that are not indexed, and thus never true
+    int unreachable_goals;
+
+    //! Masks of the ground action schemas, indexed by schema index (null for lifted ones)
+    std::vector<std::unique_ptr<GroundActionMasks>> ground_actions;
+
+    //! Index of the atom, or -1 if it is not part of any state
+    int find_index(int predicate, const std::vector<int>& arguments) const;
+
+    void create_goal_masks();
+    void create_ground_action_masks();
+
 
 public:
     explicit ExtensionalStatePacker(const Task &task);
@@ -74,6 +130,23 @@ public:
     ExtensionalPackedState pack(const DBState &state) const;
 
     DBState unpack(const ExtensionalPackedState &packed) const;
+
+    bool is_goal(const ExtensionalPackedState &packed) const {
+        return unreachable_goals == 0 && goal->is_satisfied(packed);
+    }
+
+    int count_unsatisfied_goals(const ExtensionalPackedState &packed) const {
+        return unreachable_goals + goal->count_unsatisfied(packed);
+    }
+
+    //! Check if the ground action schema is applicable in the packed state
+    bool is_ground_action_applicable(const ActionSchema &action,
+                                     const ExtensionalPackedState &packed) const;
+
+    //! Apply the operator directly on the packed state
+    ExtensionalPackedState generate_successor(const LiftedOperatorId &op,
+                                              const ActionSchema &action,
+                                              const ExtensionalPackedState &packed) const;
 };
 
 #endif // EXTENSIONAL_SEARCH_STATE_PACKER_H
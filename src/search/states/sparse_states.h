@@ -65,11 +65,11 @@ public:
 
     DBState unpack(const SparsePackedState &packed_state) const;
 
-private:
     long pack_tuple(const std::vector<int> &tuple, int predicate_index) const;
 
     std::vector<int> unpack_tuple(long tuple, int predicate_index) const;
 
+private:
     int get_index_given_predicate_and_param(int pred, int param, int element) const;
 
     int get_obj_given_predicate_and_param(int pred, int param, int element) const;
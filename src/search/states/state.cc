@@ -7,6 +7,15 @@ using namespace std;
 
 void DBState::add_tuple(int relation, const GroundAtom &args) {
   relations[relation].tuples.insert(args);
+  relation_hashes.clear();
+}
+
+void DBState::compute_relation_hashes() const {
+    relation_hashes.assign(relations.size(), 0);
+    for (size_t i = 0; i < relations.size(); ++i) {
+        for (const GroundAtom &tuple : relations[i].tuples)
+            relation_hashes[i] += hash_tuple(tuple);
+    }
 }
 
 
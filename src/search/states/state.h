@@ -29,6 +29,15 @@ class DBState {
     std::vector<Relation> relations;
     std::vector<bool> nullary_atoms;
 
+    /*
+     * Order-independent hashes of the relations (sums of the hashes of their
+     * tuples). They are computed on demand, at most once per state unless tuples
+     * are added, and are not stored in packed states.
+     */
+    mutable std::vector<std::size_t> relation_hashes;
+
+    void compute_relation_hashes() const;
+
 public:
 
     DBState() = default;
@@ -56,12 +65,22 @@ public:
         nullary_atoms[index] = v;
     }
 
+    const std::vector<std::size_t> &get_relation_hashes() const {
+        if (relation_hashes.empty())
+            compute_relation_hashes();
+        return relation_hashes;
+    }
+
+    static std::size_t hash_tuple(const GroundAtom &tuple) {
+        return TupleHash()(tuple);
+    }
+
     void set_relation_predicate_symbol(size_t i, int id) {
         relations[i].predicate_symbol = id;
     }
 
     void insert_tuple_in_relation(GroundAtom ga, int id) {
-        relations[id].tuples.insert(ga);
+        add_tuple(id, ga);
     }
 
     void add_tuple(int relation, const GroundAtom &args);
@@ -130,13 +130,14 @@ FullReducerSuccessorGenerator::FullReducerSuccessorGenerator(const Task &task)
             // cout << "Action " << action.get_name() << " is acyclic.\n";
         } else {
             priority_queue<pair<int, int>> q;
+            const auto &atoms = action_data[action.get_index()].relevant_precondition_atoms;
             full_join_order[action.get_index()].clear();
             full_join_order[action.get_index()].reserve(removed.size() + missing_precond.size());
             for (size_t k = 0; k < removed.size(); ++k) {
                 q.emplace(hyperedges[k].size(), edge_to_precond[k]);
             }
             for (size_t k = 0; k < missing_precond.size(); ++k) {
-                q.emplace(action.get_precondition()[k].arguments.size(), missing_precond[k]);
+                q.emplace(atoms[missing_precond[k]].arguments.size(), missing_precond[k]);
             }
             while (!q.empty()) {
                 int p = q.top().second;
@@ -194,14 +195,19 @@ Table FullReducerSuccessorGenerator::instantiate(const ActionSchema &action, con
         }
     }
 
+    vector<Table> negated_tables;
+    parse_negated_precond(actiondata, state, negated_tables);
+
     Table &working_table = tables[fjr[0]];
+    filter_negated_preconditions(negated_tables, working_table);
     for (size_t i = 1; i < fjr.size(); ++i) {
-        hash_join(working_table, tables[fjr[i]]);
-        filter_inequalities(action, working_table);
+        hash_join(working_table, tables[fjr[i]], actiondata.inequalities);
+        filter_negated_preconditions(negated_tables, working_table);
         if (working_table.tuples.empty()) {
             return working_table;
         }
     }
+    assert(negated_tables.empty());
 
     return working_table;
 }
@@ -3,6 +3,8 @@
 #include "generic_join_successor.h"
 
 #include "../action_schema.h"
+#include "../invariants.h"
+#include "../database/hash_anti_join.h"
 #include "../database/hash_join.h"
 #include "../database/semi_join.h"
 #include "../database/table.h"
@@ -11,18 +13,34 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iostream>
+#include <memory>
 #include <vector>
 
 using namespace std;
 
 GenericJoinSuccessor::GenericJoinSuccessor(const Task &task)
-    : static_information(task.get_static_info()), is_predicate_static(), action_data()
+    : static_information(task.get_static_info()), is_predicate_static(),
+      number_objects(task.objects.size()), action_data()
 {
     is_predicate_static.reserve(static_information.get_relations().size());
     for (const auto &r : static_information.get_relations()) {
         is_predicate_static.push_back(!r.tuples.empty());
     }
     action_data = precompile_action_data(task.actions);
+
+    // Schemas requiring two atoms of the same mutex group are never applicable
+    size_t mutex_inapplicable = 0;
+    for (const ActionSchema &action : task.actions) {
+        PrecompiledActionData &data = action_data[action.get_index()];
+        if (!data.is_ground and !data.statically_inapplicable and
+            has_mutex_preconditions(task.invariants, action)) {
+            data.statically_inapplicable = true;
+            ++mutex_inapplicable;
+        }
+    }
+    if (mutex_inapplicable > 0)
+        cout << mutex_inapplicable << " action schema(s) with mutex preconditions" << endl;
 }
 
 Table GenericJoinSuccessor::instantiate(const ActionSchema &action,
@@ -43,28 +61,34 @@ Table GenericJoinSuccessor::instantiate(const ActionSchema &action,
     assert(!tables.empty());
     assert(tables.size() == actiondata.relevant_precondition_atoms.size());
 
+    vector<Table> negated_tables;
+    parse_negated_precond(actiondata, state, negated_tables);
+
     Table &working_table = tables[0];
+    filter_negated_preconditions(negated_tables, working_table);
     for (size_t i = 1; i < tables.size(); ++i) {
-        hash_join(working_table, tables[i]);
-        // Filter out equalities
-        filter_inequalities(action, working_table);
+        hash_join(working_table, tables[i], actiondata.inequalities);
+        filter_negated_preconditions(negated_tables, working_table);
         if (working_table.tuples.empty()) {
             return working_table;
         }
     }
+    assert(negated_tables.empty());
 
     return working_table;
 }
 
-void GenericJoinSuccessor::filter_inequalities(const ActionSchema &action,
-                                               Table &working_table)
+/*
+ * Remove the tuples of a table violating some inequality over its variables. This is
+ * only needed for the tables created from the precondition atoms, since joins check
+ * the inequalities that become bound while joining.
+ */
+void GenericJoinSuccessor::filter_inequalities(const vector<pair<int, int>> &inequalities,
+                                               Table &table)
 {
-    const auto& tup_idx = working_table.tuple_index;
+    const auto& tup_idx = table.tuple_index;
 
-    // Loop over inequalities and remove those not consistent with the current instantiation
-    for (const pair<int, int>& ineq : action.get_inequalities()) {
-        // TODO Revise this, looks that some work could be offloaded to preprocessing so that we
-        //      do not need to do all this linear-time finds at runtime?
+    for (const pair<int, int>& ineq : inequalities) {
         auto it_1 = find(tup_idx.begin(), tup_idx.end(), ineq.first);
         auto it_2 = find(tup_idx.begin(), tup_idx.end(), ineq.second);
 
@@ -72,17 +96,36 @@ void GenericJoinSuccessor::filter_inequalities(const ActionSchema &action,
             int index1 = distance(tup_idx.begin(), it_1);
             int index2 = distance(tup_idx.begin(), it_2);
 
-            vector<vector<int>> newtuples;
-            for (const auto &t : working_table.tuples) {
-                if (t[index1] != t[index2]) {
-                    newtuples.push_back(t);
-                }
-            }
-            working_table.tuples = std::move(newtuples);
+            table.tuples.erase(remove_if(table.tuples.begin(), table.tuples.end(),
+                                         [&](const vector<int> &t) {
+                                             return t[index1] == t[index2];
+                                         }),
+                               table.tuples.end());
         }
     }
 }
 
+/*
+ * Anti-join the working table with every negated precondition table whose variables
+ * are all bound in it. Tables already applied are removed from the list.
+ */
+void GenericJoinSuccessor::filter_negated_preconditions(vector<Table> &negated_tables,
+                                                        Table &working_table)
+{
+    const auto& tup_idx = working_table.tuple_index;
+    for (auto it = negated_tables.begin(); it != negated_tables.end();) {
+        bool bound = all_of(it->tuple_index.begin(), it->tuple_index.end(), [&](int x) {
+            return x < 0 or find(tup_idx.begin(), tup_idx.end(), x) != tup_idx.end();
+        });
+        if (!bound) {
+            ++it;
+            continue;
+        }
+        hash_anti_join(working_table, *it);
+        it = negated_tables.erase(it);
+    }
+}
+
 void GenericJoinSuccessor::get_indices_and_constants_in_preconditions(vector<int> &indices,
                                                                       vector<int> &constants,
                                                                       const Atom &a)
@@ -101,13 +144,23 @@ void GenericJoinSuccessor::get_indices_and_constants_in_preconditions(vector<int
 
 /*
  * Select only those tuples matching the constants of a partially grounded
- * precondition.
+ * precondition and whose objects belong to the domains of the corresponding
+ * parameters.
  */
 void GenericJoinSuccessor::select_tuples(const DBState &s,
                                          const Atom &a,
                                          std::vector<GroundAtom> &tuples,
-                                         const std::vector<int> &constants)
+                                         const std::vector<int> &constants,
+                                         const std::vector<std::vector<bool>> &parameter_domains)
 {
+    // Positions of the atom whose parameter has a restricted domain
+    vector<int> restricted;
+    for (size_t i = 0; i < a.arguments.size(); ++i) {
+        const Argument &arg = a.arguments[i];
+        if (!arg.constant and !parameter_domains[arg.index].empty())
+            restricted.push_back(i);
+    }
+
     for (const GroundAtom &atom : s.get_relations()[a.predicate_symbol].tuples) {
         bool match_constants = true;
         for (int c : constants) {
@@ -117,10 +170,81 @@ void GenericJoinSuccessor::select_tuples(const DBState &s,
                 break;
             }
         }
-        if (match_constants) tuples.push_back(atom);
+        if (!match_constants) continue;
+
+        bool in_domain = true;
+        for (int r : restricted) {
+            if (!parameter_domains[a.arguments[r].index][atom[r]]) {
+                in_domain = false;
+                break;
+            }
+        }
+        if (in_domain) tuples.push_back(atom);
     }
 }
 
+/*
+ * Intersect a parameter domain (empty if unrestricted) with the allowed objects.
+ * Return false if no object is left.
+ */
+static bool intersect_domain(vector<bool> &domain, vector<bool> &&allowed)
+{
+    if (domain.empty()) {
+        domain = move(allowed);
+    }
+    else {
+        for (size_t o = 0; o < domain.size(); ++o) {
+            domain[o] = domain[o] and allowed[o];
+        }
+    }
+    return find(domain.begin(), domain.end(), true) != domain.end();
+}
+
+/*
+ * Intersect the domain of the parameter of a unary static atom with the objects
+ * for which the atom holds. Return false if no object is left (or, if the argument
+ * is a constant, if the ground atom does not hold), i.e., if the schema is
+ * statically inapplicable.
+ */
+bool GenericJoinSuccessor::restrict_parameter_domain(
+    const Atom &a, vector<vector<bool>> &parameter_domains) const
+{
+    assert(a.arguments.size() == 1 and is_static(a.predicate_symbol));
+    const Argument &arg = a.arguments[0];
+    const auto &tuples = get_tuples_from_static_relation(a.predicate_symbol);
+    if (arg.constant) {
+        return tuples.count(GroundAtom{arg.index}) > 0;
+    }
+
+    vector<bool> allowed(number_objects, false);
+    for (const GroundAtom &t : tuples) {
+        allowed[t[0]] = true;
+    }
+
+    return intersect_domain(parameter_domains[arg.index], move(allowed));
+}
+
+/*
+ * Intersect the parameter domains with the objects the translator found to be
+ * relaxed reachable for each parameter. Return false if some domain becomes empty.
+ */
+bool GenericJoinSuccessor::restrict_to_reachable_objects(
+    const ActionSchema &action, vector<vector<bool>> &parameter_domains) const
+{
+    const auto &reachable_objects = action.get_reachable_objects();
+    for (size_t i = 0; i < reachable_objects.size(); ++i) {
+        if (reachable_objects[i].empty())
+            continue;
+        vector<bool> allowed(number_objects, false);
+        for (int o : reachable_objects[i]) {
+            if (o >= 0) allowed[o] = true;
+        }
+        if (!intersect_domain(parameter_domains[i], move(allowed)))
+            return false;
+    }
+    return true;
+}
+
 std::vector<PrecompiledActionData>
 GenericJoinSuccessor::precompile_action_data(const std::vector<ActionSchema>& actions) {
     std::vector<PrecompiledActionData> result;
@@ -138,21 +262,82 @@ PrecompiledActionData GenericJoinSuccessor::precompile_action_data(const ActionS
     if (data.is_ground) return data; // We won't need anything from this action
 
 
+    data.parameter_domains.resize(action.get_parameters().size());
+    data.inequalities = action.get_inequalities();
+
+    // The first unary static atom over each parameter, in case we need to keep it as a table
+    vector<const Atom *> domain_atoms(action.get_parameters().size(), nullptr);
+
+    vector<const Atom *> negated_atoms;
+
     for (const Atom &p : action.get_precondition()) {
         bool is_ineq = (p.name == "=");
-        if (p.negated and !is_ineq) {
-            throw std::runtime_error("Actions with negated preconditions not supported yet");
-        }
 
         // Nullary atoms are handled differently, they don't result in DB tables
-        if (!p.arguments.empty() and !is_ineq) {
-            data.relevant_precondition_atoms.push_back(p);
+        if (p.arguments.empty() or is_ineq) continue;
+
+        if (p.negated) {
+            negated_atoms.push_back(&p);
+            continue;
+        }
+
+        // Unary static atoms (e.g., types) are compiled into parameter domains which are
+        // checked when selecting the tuples of the other tables, instead of being joined
+        if (p.arguments.size() == 1 and is_static(p.predicate_symbol)) {
+            if (!restrict_parameter_domain(p, data.parameter_domains)) {
+                data.statically_inapplicable = true;
+                return data;
+            }
+            if (!p.arguments[0].constant and !domain_atoms[p.arguments[0].index])
+                domain_atoms[p.arguments[0].index] = &p;
+            continue;
+        }
+
+        data.relevant_precondition_atoms.push_back(p);
+    }
+
+    if (!restrict_to_reachable_objects(action, data.parameter_domains)) {
+        data.statically_inapplicable = true;
+        return data;
+    }
+
+    // Parameters that only occur in unary static atoms still need a table enumerating
+    // their domain
+    vector<bool> occurs(action.get_parameters().size(), false);
+    for (const Atom &p : data.relevant_precondition_atoms) {
+        for (const Argument &arg : p.arguments) {
+            if (!arg.constant) occurs[arg.index] = true;
+        }
+    }
+    for (size_t i = 0; i < domain_atoms.size(); ++i) {
+        if (domain_atoms[i] and !occurs[i]) {
+            data.relevant_precondition_atoms.push_back(*domain_atoms[i]);
         }
     }
 
     // TODO (GFM): Not sure why this assert is here and why should we fail for it :-)
     assert(!data.relevant_precondition_atoms.empty());
 
+    for (const Atom *atom : negated_atoms) {
+        if (!is_static(atom->predicate_symbol)) {
+            data.negated_fluent_tables.push_back(data.negated_precondition_atoms.size());
+            data.negated_precondition_atoms.push_back(*atom);
+            data.negated_precompiled_db.emplace_back();
+            continue;
+        }
+
+        vector<GroundAtom> tuples;
+        vector<int> constants, indices;
+        get_indices_and_constants_in_preconditions(indices, constants, *atom);
+        select_tuples(static_information, *atom, tuples, constants, data.parameter_domains);
+
+        // If no tuple matches, the negated atom holds for any instantiation
+        if (tuples.empty()) continue;
+
+        data.negated_precondition_atoms.push_back(*atom);
+        data.negated_precompiled_db.emplace_back(move(tuples), move(indices));
+    }
+
     // Create N empty tables
     data.precompiled_db.resize(data.relevant_precondition_atoms.size());
 
@@ -172,14 +357,17 @@ PrecompiledActionData GenericJoinSuccessor::precompile_action_data(const ActionS
 
         get_indices_and_constants_in_preconditions(indices, constants, atom);
 
-        select_tuples(static_information, atom, tuples, constants);
+        select_tuples(static_information, atom, tuples, constants, data.parameter_domains);
+
+        Table table(move(tuples), move(indices));
+        filter_inequalities(data.inequalities, table);
 
-        if (tuples.empty()) {
+        if (table.tuples.empty()) {
             data.statically_inapplicable = true;
             return data;
         }
 
-        data.precompiled_db[i] = Table(move(tuples), move(indices));
+        data.precompiled_db[i] = move(table);
     }
 
     return data;
@@ -217,22 +405,45 @@ bool GenericJoinSuccessor::parse_precond_into_join_program(
         // TODO the call next line should be performed at preprocessing as well. We should keep in
         //      adata the vector of constants and indices *for each precondition atom*
         get_indices_and_constants_in_preconditions(indices, constants, atom);
-        select_tuples(state, atom, tuples, constants);
-
-        if (tuples.empty()) return false;
+        select_tuples(state, atom, tuples, constants, adata.parameter_domains);
 
         tables[i] = Table(move(tuples), move(indices));
+        filter_inequalities(adata.inequalities, tables[i]);
+
+        if (tables[i].tuples.empty()) return false;
     }
 
     return true;
 }
 
 
+void GenericJoinSuccessor::parse_negated_precond(
+    const PrecompiledActionData &adata, const DBState &state, std::vector<Table>& tables) const
+{
+    tables = adata.negated_precompiled_db;
+    for (unsigned i:adata.negated_fluent_tables) {
+        const Atom &atom = adata.negated_precondition_atoms[i];
+        assert(!is_static(atom.predicate_symbol));
+
+        vector<GroundAtom> tuples;
+        vector<int> constants, indices;
+        get_indices_and_constants_in_preconditions(indices, constants, atom);
+        select_tuples(state, atom, tuples, constants, adata.parameter_domains);
+
+        tables[i] = Table(move(tuples), move(indices));
+    }
+
+    tables.erase(remove_if(tables.begin(), tables.end(), [](const Table &t) {
+        return t.tuples.empty();
+    }), tables.end());
+}
+
 /*
  * Create hypergraph of precondition
  *
- * Loop through every precondition and filters out negated and nullary atoms.
- * Then, assign each free variable of the precondition to a corresponding index
+ * Loop through every relevant precondition atom of the schema, i.e., those with
+ * a table in the join program, so edges are indexed in the same way as the
+ * tables. Then, assign each free variable of the precondition to a corresponding index
  * and create the hyperedge of the vertice with these indices.
  *
  * If there is no free variable in a precondition (i.e., ground atom
@@ -246,13 +457,10 @@ void GenericJoinSuccessor::create_hypergraph(const ActionSchema &action,
                                              vector<int> &missing_precond,
                                              map<int, int> &node_index,
                                              map<int, int> &node_counter,
-                                             map<int, int> &edge_to_precond)
+                                             map<int, int> &edge_to_precond) const
 {
     int cont = 0;
-    for (const Atom &p : action.get_precondition()) {
-        if (p.negated or p.arguments.empty()) {
-            continue;
-        }
+    for (const Atom &p : action_data[action.get_index()].relevant_precondition_atoms) {
         set<int> args;
         bool has_free_variables = false;
         for (Argument arg : p.arguments) {
@@ -422,8 +630,18 @@ std::vector<LiftedOperatorId> GenericJoinSuccessor::get_applicable_actions(
         return applicable;
     }
 
+    size_t cache_key = 0;
+    if (instantiation_cache) {
+        cache_key = instantiation_cache->compute_key(action.get_index(), state);
+        const auto *cached = instantiation_cache->lookup(action.get_index(), cache_key, state);
+        if (cached)
+            return *cached;
+    }
+
     Table instantiations = instantiate(action, state);
     if (instantiations.tuples.empty()) { // No applicable action from this schema
+        if (instantiation_cache)
+            instantiation_cache->insert(action.get_index(), cache_key, state, applicable);
         return applicable;
     }
 
@@ -438,9 +656,31 @@ std::vector<LiftedOperatorId> GenericJoinSuccessor::get_applicable_actions(
             free_var_indices, map_indices_to_position, tuple_with_const, ordered_tuple);
         applicable.emplace_back(action.get_index(), move(ordered_tuple));
     }
+    if (instantiation_cache)
+        instantiation_cache->insert(action.get_index(), cache_key, state, applicable);
     return applicable;
 }
 
+void GenericJoinSuccessor::enable_instantiation_cache(const Task &task)
+{
+    instantiation_cache = make_unique<InstantiationCache>(task);
+    for (const ActionSchema &action : task.actions) {
+        const PrecompiledActionData &data = action_data[action.get_index()];
+        vector<int> read_predicates;
+        for (unsigned i : data.fluent_tables)
+            read_predicates.push_back(data.relevant_precondition_atoms[i].predicate_symbol);
+        for (unsigned i : data.negated_fluent_tables)
+            read_predicates.push_back(data.negated_precondition_atoms[i].predicate_symbol);
+        instantiation_cache->set_read_set(action.get_index(), move(read_predicates));
+    }
+}
+
+void GenericJoinSuccessor::print_statistics() const
+{
+    if (instantiation_cache)
+        instantiation_cache->print_statistics();
+}
+
 
 /**
  *    This action generates the ground atom produced by an atomic effect given an instantiation of
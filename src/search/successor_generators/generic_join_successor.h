@@ -1,10 +1,12 @@
 #ifndef SEARCH_GENERIC_JOIN_SUCCESSOR_H
 #define SEARCH_GENERIC_JOIN_SUCCESSOR_H
 
+#include "instantiation_cache.h"
 #include "successor_generator.h"
 #include "../structures.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <unordered_set>
 #include <vector>
@@ -52,6 +54,21 @@ public:
                                                        const DBState &state,
                                                        std::vector<Table>& tables);
 
+    /**
+    * Create the tables corresponding to the negated preconditions of the given action.
+    *
+    * Tables of negated atoms over static predicates are already precompiled, the
+    * remaining ones are selected from the state. Empty tables are skipped, since
+    * the corresponding negated atoms hold for any instantiation.
+    *
+    * @param adata: A set of relevant data corresponding to the action in question
+    * @param state: state being evaluated
+    * @param tables: the set of tables, output parameter.
+    */
+    void parse_negated_precond(const PrecompiledActionData &adata,
+                               const DBState &state,
+                               std::vector<Table>& tables) const;
+
     DBState generate_successor(const LiftedOperatorId &op,
                                const ActionSchema& action,
                                const DBState &state) override;
@@ -65,15 +82,29 @@ public:
     const std::unordered_set<GroundAtom, TupleHash>
     &get_tuples_from_static_relation(size_t i) const;
 
+    /**
+     * Reuse the applicable instantiations of a schema in states where the fluent
+     * relations it reads are the same as in some previously seen state.
+     *
+     * @see instantiation_cache.h
+     */
+    void enable_instantiation_cache(const Task &task);
+
+    void print_statistics() const override;
+
 
 protected:
     const StaticInformation& static_information;
 
     std::vector<bool> is_predicate_static;
 
+    std::size_t number_objects;
+
     //! Some data relevant to each action schema, indexed by schema index
     std::vector<PrecompiledActionData> action_data;
 
+    std::unique_ptr<InstantiationCache> instantiation_cache;
+
     bool is_static(size_t i) const { return is_predicate_static[i]; }
 
     static void get_indices_and_constants_in_preconditions(std::vector<int> &indices,
@@ -83,18 +114,28 @@ protected:
     static void select_tuples(const DBState &s,
                               const Atom &a,
                               std::vector<GroundAtom> &tuples,
-                              const std::vector<int> &constants);
+                              const std::vector<int> &constants,
+                              const std::vector<std::vector<bool>> &parameter_domains);
+
+    bool restrict_parameter_domain(const Atom &a,
+                                   std::vector<std::vector<bool>> &parameter_domains) const;
+
+    bool restrict_to_reachable_objects(const ActionSchema &action,
+                                       std::vector<std::vector<bool>> &parameter_domains) const;
+
+    static void filter_inequalities(const std::vector<std::pair<int, int>> &inequalities,
+                                    Table &table);
 
-    static void filter_inequalities(const ActionSchema &action,
-                             Table &working_table) ;
-    static void create_hypergraph(
+    static void filter_negated_preconditions(std::vector<Table> &negated_tables,
+                                             Table &working_table);
+    void create_hypergraph(
         const ActionSchema &action,
         std::vector<int> &hypernodes,
         std::vector<std::set<int>> &hyperedges,
         std::vector<int> &missing_precond,
         std::map<int, int> &node_index,
         std::map<int, int> &node_counter,
-        std::map<int, int> &edge_to_precond);
+        std::map<int, int> &edge_to_precond) const;
 
     std::vector<PrecompiledActionData> precompile_action_data(
         const std::vector<ActionSchema>& actions);
@@ -131,7 +172,8 @@ public:
     PrecompiledActionData() :
         is_ground(false), statically_inapplicable(false),
         relevant_precondition_atoms(), fluent_tables(),
-        precompiled_db()
+        precompiled_db(), parameter_domains(), inequalities(), negated_precondition_atoms(),
+        negated_fluent_tables(), negated_precompiled_db()
     {}
 
     //! Whether the action has no parameters
@@ -148,6 +190,25 @@ public:
 
     //! A set of tables with all static info precompiled for faster access at runtime
     std::vector<Table> precompiled_db;
+
+    //! The objects each parameter can take, compiled from the unary static preconditions
+    //! (mostly type predicates) of the schema, indexed by parameter and then by object.
+    //! An empty vector means that the parameter is not restricted.
+    std::vector<std::vector<bool>> parameter_domains;
+
+    //! The inequalities of the schema. Tables are filtered by the inequalities over their own
+    //! variables when created; the remaining ones are checked inside the joins.
+    std::vector<std::pair<int, int>> inequalities;
+
+    //! Negated (non-equality) precondition atoms, checked with anti-joins once all their
+    //! variables are bound in the join program
+    std::vector<Atom> negated_precondition_atoms;
+
+    //! A list of the indices in `negated_precondition_atoms` that correspond to fluent atoms.
+    std::vector<unsigned> negated_fluent_tables;
+
+    //! The tables of the negated static atoms, precompiled as the positive ones
+    std::vector<Table> negated_precompiled_db;
 };
 
 #endif //SEARCH_GENERIC_JOIN_SUCCESSOR_H
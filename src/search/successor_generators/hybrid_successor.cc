@@ -0,0 +1,372 @@
+#include "hybrid_successor.h"
+
+#include "../action.h"
+#include "../database/table.h"
+#include "../invariants.h"
+#include "../task.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <unordered_set>
+
+using namespace std;
+
+static GroundAtom instantiate_atom(const Atom &atom, const vector<int> &instantiation)
+{
+    GroundAtom ground_atom;
+    ground_atom.reserve(atom.arguments.size());
+    for (const Argument &arg : atom.arguments) {
+        ground_atom.push_back(arg.constant ? arg.index : instantiation[arg.index]);
+    }
+    return ground_atom;
+}
+
+HybridSuccessorGenerator::HybridSuccessorGenerator(const Task &task, int threshold,
+                                                   utils::Budget &budget)
+    : YannakakisSuccessorGenerator(task), ground_schemas(task.actions.size())
+{
+    vector<vector<vector<int>>> instantiations(task.actions.size());
+    vector<bool> lifted(task.actions.size(), false);
+    if (!compute_relaxed_reachable_instantiations(task, threshold, budget, instantiations, lifted)) {
+        cout << "Budget exhausted while grounding, all action schemas are kept lifted" << endl;
+        return;
+    }
+
+    size_t grounded_schemas = 0, ground_operators = 0;
+    for (const ActionSchema &action : task.actions) {
+        auto &schema_instantiations = instantiations[action.get_index()];
+        if (action.is_ground() or lifted[action.get_index()])
+            continue;
+        ++grounded_schemas;
+        ground_operators += schema_instantiations.size();
+        ground_schemas[action.get_index()] = create_ground_schema(action, move(schema_instantiations));
+    }
+    cout << "Grounded " << grounded_schemas << " action schema(s) with "
+         << ground_operators << " relaxed-reachable ground action(s)" << endl;
+}
+
+/*
+ * Keep the schema lifted and stop enumerating its instantiations. As its effects
+ * are not known anymore, every atom of the predicates it adds is considered
+ * reachable: schemas with positive fluent preconditions on these predicates are
+ * kept lifted as well, and nullary effects are made true in the relaxed state.
+ */
+void HybridSuccessorGenerator::keep_lifted(const Task &task,
+                                           int action_index,
+                                           DBState &relaxed_state,
+                                           vector<bool> &lifted,
+                                           vector<bool> &saturated_predicates) const
+{
+    vector<int> queue = {action_index};
+    lifted[action_index] = true;
+    while (!queue.empty()) {
+        const ActionSchema &action = task.actions[queue.back()];
+        queue.pop_back();
+        for (size_t i = 0; i < action.get_positive_nullary_effects().size(); ++i) {
+            if (action.get_positive_nullary_effects()[i])
+                relaxed_state.set_nullary_atom(i, true);
+        }
+        for (const Atom &eff : action.get_effects()) {
+            if (!eff.negated)
+                saturated_predicates[eff.predicate_symbol] = true;
+        }
+        for (const ActionSchema &other : task.actions) {
+            if (lifted[other.get_index()])
+                continue;
+            for (const Atom &precond : other.get_precondition()) {
+                if (!precond.negated and precond.name != "=" and
+                    saturated_predicates[precond.predicate_symbol]) {
+                    lifted[other.get_index()] = true;
+                    queue.push_back(other.get_index());
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Compute the instantiations of all schemas in the delete relaxation. Negated
+ * fluent preconditions are ignored by temporarily removing their tables from the
+ * precompiled data of the schemas, and nullary ones are not checked. Instantiations
+ * requiring two mutex atoms are never applicable, so they are discarded.
+ *
+ * A schema with more than 'threshold' instantiations, or whose intermediate joins
+ * exceed MAX_GROUNDING_FACTOR * threshold tuples, is kept lifted (see keep_lifted)
+ * and not enumerated anymore. The joins of a schema are interrupted as soon as they
+ * exceed its limit, so no large relaxed table is ever built. The other schemas are
+ * still grounded.
+ *
+ * Returns false if the budget is exhausted.
+ */
+bool HybridSuccessorGenerator::compute_relaxed_reachable_instantiations(
+    const Task &task,
+    size_t threshold,
+    utils::Budget &budget,
+    vector<vector<vector<int>>> &instantiations,
+    vector<bool> &lifted)
+{
+    vector<vector<unsigned>> negated_fluent_tables;
+    for (PrecompiledActionData &data : action_data) {
+        negated_fluent_tables.push_back(move(data.negated_fluent_tables));
+        data.negated_fluent_tables.clear();
+    }
+
+    vector<unordered_set<vector<int>, TupleHash>> reached(task.actions.size());
+    DBState relaxed_state(task.initial_state);
+    vector<bool> saturated_predicates(task.predicates.size(), false);
+    size_t mutex_pruned = 0;
+    bool changed = true, budget_exhausted = false;
+    while (changed and !budget_exhausted) {
+        changed = false;
+        for (const ActionSchema &action : task.actions) {
+            if (budget.is_exhausted()) {
+                budget_exhausted = true;
+                break;
+            }
+            if (lifted[action.get_index()])
+                continue;
+            const auto &positive_nullary = action.get_positive_nullary_precond();
+            bool nullary_precondition_holds = true;
+            for (size_t i = 0; i < positive_nullary.size(); ++i) {
+                if (positive_nullary[i] and !relaxed_state.get_nullary_atoms()[i])
+                    nullary_precondition_holds = false;
+            }
+            if (!nullary_precondition_holds)
+                continue;
+
+            vector<vector<int>> new_instantiations;
+            if (action.is_ground()) {
+                if (is_relaxed_applicable(action, relaxed_state))
+                    new_instantiations.emplace_back();
+            }
+            else {
+                join_size_limit = threshold * MAX_GROUNDING_FACTOR;
+                join_size_limit_exceeded = false;
+                Table table = instantiate(action, relaxed_state);
+                if (join_size_limit_exceeded or table.tuples.size() > join_size_limit) {
+                    keep_lifted(task, action.get_index(), relaxed_state, lifted, saturated_predicates);
+                    changed = true;
+                    continue;
+                }
+                vector<int> free_var_indices;
+                vector<int> map_indices_to_position;
+                compute_map_indices_to_table_positions(
+                    table, free_var_indices, map_indices_to_position);
+                for (const vector<int> &tuple_with_const : table.tuples) {
+                    vector<int> ordered_tuple(free_var_indices.size());
+                    order_tuple_by_free_variable_order(
+                        free_var_indices, map_indices_to_position, tuple_with_const, ordered_tuple);
+                    new_instantiations.push_back(move(ordered_tuple));
+                }
+            }
+
+            auto &schema_reached = reached[action.get_index()];
+            for (vector<int> &instantiation : new_instantiations) {
+                if (!schema_reached.insert(instantiation).second)
+                    continue;
+                if (requires_mutex_atoms(task, action, instantiation)) {
+                    ++mutex_pruned;
+                    continue;
+                }
+                if (instantiations[action.get_index()].size() >= threshold) {
+                    keep_lifted(task, action.get_index(), relaxed_state, lifted, saturated_predicates);
+                    changed = true;
+                    break;
+                }
+                for (size_t i = 0; i < action.get_positive_nullary_effects().size(); ++i) {
+                    if (action.get_positive_nullary_effects()[i] and
+                        !relaxed_state.get_nullary_atoms()[i]) {
+                        relaxed_state.set_nullary_atom(i, true);
+                        changed = true;
+                    }
+                }
+                for (const Atom &eff : action.get_effects()) {
+                    if (eff.negated)
+                        continue;
+                    GroundAtom atom = instantiate_atom(eff, instantiation);
+                    if (relaxed_state.get_tuples_of_relation(eff.predicate_symbol).count(atom) == 0) {
+                        relaxed_state.insert_tuple_in_relation(move(atom), eff.predicate_symbol);
+                        changed = true;
+                    }
+                }
+                instantiations[action.get_index()].push_back(move(instantiation));
+            }
+        }
+    }
+
+    join_size_limit = numeric_limits<size_t>::max();
+    join_size_limit_exceeded = false;
+    for (size_t i = 0; i < action_data.size(); ++i) {
+        action_data[i].negated_fluent_tables = move(negated_fluent_tables[i]);
+    }
+    if (mutex_pruned > 0)
+        cout << "Discarded " << mutex_pruned << " relaxed-reachable instantiation(s) with mutex preconditions" << endl;
+    return !budget_exhausted;
+}
+
+bool HybridSuccessorGenerator::requires_mutex_atoms(const Task &task,
+                                                    const ActionSchema &action,
+                                                    const vector<int> &instantiation) const
+{
+    if (task.invariants.empty())
+        return false;
+    vector<pair<int, GroundAtom>> atoms;
+    for (const Atom &precond : action.get_precondition()) {
+        if (!precond.negated and precond.name != "=" and !is_static(precond.predicate_symbol))
+            atoms.emplace_back(precond.predicate_symbol, instantiate_atom(precond, instantiation));
+    }
+    const auto &positive_nullary = action.get_positive_nullary_precond();
+    for (size_t p = 0; p < positive_nullary.size(); ++p) {
+        if (positive_nullary[p])
+            atoms.emplace_back(p, GroundAtom());
+    }
+    for (size_t i = 0; i < atoms.size(); ++i) {
+        for (size_t j = i + 1; j < atoms.size(); ++j) {
+            if (are_mutex(task.invariants, atoms[i].first, atoms[i].second,
+                          atoms[j].first, atoms[j].second))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool HybridSuccessorGenerator::is_relaxed_applicable(const ActionSchema &action,
+                                                     const DBState &relaxed_state) const
+{
+    if (action_data[action.get_index()].statically_inapplicable)
+        return false;
+    for (const Atom &precond : action.get_precondition()) {
+        GroundAtom tuple = instantiate_atom(precond, {});
+        if (precond.name == "=") {
+            if ((tuple[0] == tuple[1]) == precond.negated)
+                return false;
+            continue;
+        }
+        if (is_static(precond.predicate_symbol)) {
+            bool holds = get_tuples_from_static_relation(precond.predicate_symbol).count(tuple) > 0;
+            if (holds == precond.negated)
+                return false;
+        }
+        else if (!precond.negated and
+                 relaxed_state.get_tuples_of_relation(precond.predicate_symbol).count(tuple) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Create the table of ground operators of the schema. Static preconditions and
+ * inequalities hold for all relaxed-reachable instantiations, so only the fluent
+ * preconditions are kept. The index uses the positive fluent precondition with the
+ * largest number of different ground atoms among the operators.
+ */
+unique_ptr<HybridSuccessorGenerator::GroundSchema> HybridSuccessorGenerator::create_ground_schema(
+    const ActionSchema &action, vector<vector<int>> &&instantiations) const
+{
+    auto schema = make_unique<GroundSchema>();
+    const PrecompiledActionData &data = action_data[action.get_index()];
+
+    vector<const Atom *> positive_fluent;
+    for (const Atom &precond : action.get_precondition()) {
+        if (!precond.negated and precond.name != "=" and !is_static(precond.predicate_symbol))
+            positive_fluent.push_back(&precond);
+    }
+
+    for (vector<int> &instantiation : instantiations) {
+        GroundOperator op;
+        for (const Atom *precond : positive_fluent) {
+            op.positive_precondition.emplace_back(precond->predicate_symbol,
+                                                  instantiate_atom(*precond, instantiation));
+        }
+        for (unsigned i : data.negated_fluent_tables) {
+            const Atom &precond = data.negated_precondition_atoms[i];
+            op.negative_precondition.emplace_back(precond.predicate_symbol,
+                                                  instantiate_atom(precond, instantiation));
+        }
+        op.instantiation = move(instantiation);
+        schema->operators.push_back(move(op));
+    }
+
+    int index_position = -1;
+    size_t most_atoms = 0;
+    for (size_t i = 0; i < positive_fluent.size(); ++i) {
+        unordered_set<GroundAtom, TupleHash> atoms;
+        for (const GroundOperator &op : schema->operators)
+            atoms.insert(op.positive_precondition[i].second);
+        if (index_position == -1 or atoms.size() > most_atoms) {
+            index_position = i;
+            most_atoms = atoms.size();
+        }
+    }
+    if (index_position != -1) {
+        schema->index_predicate = positive_fluent[index_position]->predicate_symbol;
+        for (size_t op = 0; op < schema->operators.size(); ++op) {
+            const GroundAtom &atom = schema->operators[op].positive_precondition[index_position].second;
+            schema->operators_by_atom[atom].push_back(op);
+        }
+    }
+    return schema;
+}
+
+bool HybridSuccessorGenerator::is_applicable(const GroundOperator &op, const DBState &state)
+{
+    for (const auto &precond : op.positive_precondition) {
+        if (state.get_tuples_of_relation(precond.first).count(precond.second) == 0)
+            return false;
+    }
+    for (const auto &precond : op.negative_precondition) {
+        if (state.get_tuples_of_relation(precond.first).count(precond.second) > 0)
+            return false;
+    }
+    return true;
+}
+
+vector<LiftedOperatorId> HybridSuccessorGenerator::get_applicable_actions(
+    const ActionSchema &action, const DBState &state)
+{
+    const GroundSchema *schema = ground_schemas[action.get_index()].get();
+    if (!schema)
+        return YannakakisSuccessorGenerator::get_applicable_actions(action, state);
+
+    vector<LiftedOperatorId> applicable;
+    if (is_trivially_inapplicable(state, action)) {
+        return applicable;
+    }
+
+    auto add_if_applicable = [&](int op_index) {
+        const GroundOperator &op = schema->operators[op_index];
+        if (is_applicable(op, state))
+            applicable.emplace_back(action.get_index(), vector<int>(op.instantiation));
+    };
+
+    if (schema->index_predicate == -1) {
+        for (size_t op = 0; op < schema->operators.size(); ++op)
+            add_if_applicable(op);
+        return applicable;
+    }
+
+    // Loop over the smaller of the relation in the state and the index
+    const auto &tuples = state.get_tuples_of_relation(schema->index_predicate);
+    if (tuples.size() < schema->operators_by_atom.size()) {
+        for (const GroundAtom &tuple : tuples) {
+            auto it = schema->operators_by_atom.find(tuple);
+            if (it == schema->operators_by_atom.end())
+                continue;
+            for (int op : it->second)
+                add_if_applicable(op);
+        }
+    }
+    else {
+        for (const auto &entry : schema->operators_by_atom) {
+            if (tuples.count(entry.first) == 0)
+                continue;
+            for (int op : entry.second)
+                add_if_applicable(op);
+        }
+    }
+    return applicable;
+}
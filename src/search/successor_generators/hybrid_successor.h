@@ -0,0 +1,86 @@
+#ifndef SEARCH_HYBRID_SUCCESSOR_H
+#define SEARCH_HYBRID_SUCCESSOR_H
+
+#include "yannakakis.h"
+
+#include "../utils/budget.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Successor generator that grounds the action schemas with few relaxed-reachable
+ * instantiations and uses the Yannakakis join program for the remaining ones.
+ *
+ * @details At construction time, we compute the instantiations of every schema
+ * that are reachable in the delete relaxation (ignoring negated fluent
+ * preconditions), using the join program of the lifted generator on an
+ * accumulating relaxed state. Schemas with at most 'threshold' instantiations are
+ * then replaced by a table of ground operators, indexed by the ground atom of one
+ * of their positive fluent preconditions. Applicability of these schemas in a
+ * state is checked by looking up the atoms of the index predicate in the table and
+ * testing the remaining preconditions of the matching operators with hash lookups.
+ *
+ * The enumeration of a schema stops as soon as it has more than 'threshold'
+ * instantiations or one of its joins exceeds MAX_GROUNDING_FACTOR * threshold
+ * tuples. The schema then stays lifted, and all atoms of the predicates it adds
+ * are considered relaxed-reachable, so the schemas depending on them stay lifted
+ * too. The remaining schemas are still grounded. If the budget of the planner is
+ * exhausted, all schemas stay lifted. If the task has invariants, instantiations
+ * with mutex preconditions are discarded.
+ *
+ * @see yannakakis.cc
+ */
+class HybridSuccessorGenerator : public YannakakisSuccessorGenerator {
+    struct GroundOperator {
+        std::vector<int> instantiation;
+        std::vector<std::pair<int, GroundAtom>> positive_precondition;
+        std::vector<std::pair<int, GroundAtom>> negative_precondition;
+    };
+
+    struct GroundSchema {
+        std::vector<GroundOperator> operators;
+
+        //! Predicate of the precondition used as index, or -1 if there is none
+        int index_predicate = -1;
+        std::unordered_map<GroundAtom, std::vector<int>, TupleHash> operators_by_atom;
+    };
+
+    static const int MAX_GROUNDING_FACTOR = 10;
+
+    //! Ground tables indexed by schema index, null for schemas kept lifted
+    std::vector<std::unique_ptr<GroundSchema>> ground_schemas;
+
+    bool compute_relaxed_reachable_instantiations(
+        const Task &task,
+        std::size_t threshold,
+        utils::Budget &budget,
+        std::vector<std::vector<std::vector<int>>> &instantiations,
+        std::vector<bool> &lifted);
+
+    void keep_lifted(const Task &task,
+                     int action_index,
+                     DBState &relaxed_state,
+                     std::vector<bool> &lifted,
+                     std::vector<bool> &saturated_predicates) const;
+
+    bool is_relaxed_applicable(const ActionSchema &action, const DBState &relaxed_state) const;
+
+    bool requires_mutex_atoms(const Task &task,
+                              const ActionSchema &action,
+                              const std::vector<int> &instantiation) const;
+
+    std::unique_ptr<GroundSchema> create_ground_schema(
+        const ActionSchema &action, std::vector<std::vector<int>> &&instantiations) const;
+
+    static bool is_applicable(const GroundOperator &op, const DBState &state);
+
+public:
+    HybridSuccessorGenerator(const Task &task, int threshold, utils::Budget &budget);
+
+    std::vector<LiftedOperatorId> get_applicable_actions(
+        const ActionSchema &action, const DBState &state) override;
+};
+
+#endif //SEARCH_HYBRID_SUCCESSOR_H
@@ -0,0 +1,87 @@
+#include "instantiation_cache.h"
+
+#include "../states/state.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+void InstantiationCache::set_read_set(int schema, vector<int> read_predicates)
+{
+    if (size_t(schema) >= schemas.size())
+        schemas.resize(schema + 1);
+    sort(read_predicates.begin(), read_predicates.end());
+    read_predicates.erase(unique(read_predicates.begin(), read_predicates.end()),
+                          read_predicates.end());
+    schemas[schema].read_predicates = move(read_predicates);
+}
+
+size_t InstantiationCache::compute_key(int schema, const DBState &state) const
+{
+    const vector<size_t> &relation_hashes = state.get_relation_hashes();
+    size_t key = 0;
+    for (int p : schemas[schema].read_predicates)
+        key = key * 1000003 + relation_hashes[p] + state.get_tuples_of_relation(p).size();
+    return key;
+}
+
+bool InstantiationCache::matches(const SchemaCache &schema, const Entry &entry,
+                                 const DBState &state) const
+{
+    for (size_t i = 0; i < schema.read_predicates.size(); ++i) {
+        const auto &tuples = state.get_tuples_of_relation(schema.read_predicates[i]);
+        if (tuples.size() != entry.relations[i].size())
+            return false;
+        for (long tuple : entry.relations[i]) {
+            if (tuples.count(packer.unpack_tuple(tuple, schema.read_predicates[i])) == 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+const vector<LiftedOperatorId> *InstantiationCache::lookup(int schema, size_t key, const DBState &state)
+{
+    const SchemaCache &schema_cache = schemas[schema];
+    auto it = schema_cache.entries.find(key);
+    if (it != schema_cache.entries.end()) {
+        for (const Entry &entry : it->second) {
+            if (matches(schema_cache, entry, state)) {
+                ++hits;
+                return &entry.applicable;
+            }
+        }
+    }
+    ++misses;
+    return nullptr;
+}
+
+void InstantiationCache::insert(int schema, size_t key, const DBState &state,
+                                const vector<LiftedOperatorId> &applicable)
+{
+    SchemaCache &schema_cache = schemas[schema];
+    if (schema_cache.number_entries >= MAX_ENTRIES_PER_SCHEMA) {
+        schema_cache.entries.clear();
+        schema_cache.number_entries = 0;
+    }
+
+    Entry entry;
+    for (int p : schema_cache.read_predicates) {
+        const auto &tuples = state.get_tuples_of_relation(p);
+        vector<long> packed;
+        packed.reserve(tuples.size());
+        for (const GroundAtom &tuple : tuples)
+            packed.push_back(packer.pack_tuple(tuple, p));
+        entry.relations.push_back(move(packed));
+    }
+    entry.applicable = applicable;
+    schema_cache.entries[key].push_back(move(entry));
+    ++schema_cache.number_entries;
+}
+
+void InstantiationCache::print_statistics() const
+{
+    cout << "Instantiation cache hits: " << hits << endl;
+    cout << "Instantiation cache misses: " << misses << endl;
+}
@@ -0,0 +1,73 @@
+#ifndef SEARCH_INSTANTIATION_CACHE_H
+#define SEARCH_INSTANTIATION_CACHE_H
+
+#include "../action.h"
+#include "../structures.h"
+#include "../states/sparse_states.h"
+
+#include <unordered_map>
+#include <vector>
+
+class DBState;
+class Task;
+
+/**
+ * Cache of the applicable instantiations of each action schema, keyed by the
+ * contents of the fluent relations the schema reads.
+ *
+ * @details The join program of a schema only depends on the relations of its
+ * fluent preconditions, so states that agree on these relations have the same
+ * applicable instantiations, no matter how they were reached. The key of a schema
+ * combines the order-independent hashes of the read relations, which a state
+ * computes once for all schemas (see DBState::get_relation_hashes). Entries store the read relations as
+ * packed tuple codes, and a lookup compares them with the state only for entries
+ * with the same key, so there are no false hits. Nullary preconditions are checked
+ * before looking up the cache.
+ *
+ * The cache of a schema is cleared when it holds MAX_ENTRIES_PER_SCHEMA entries.
+ */
+class InstantiationCache {
+    struct Entry {
+        //! Packed tuples of each read relation
+        std::vector<std::vector<long>> relations;
+        std::vector<LiftedOperatorId> applicable;
+    };
+
+    struct SchemaCache {
+        std::vector<int> read_predicates;
+        std::unordered_map<std::size_t, std::vector<Entry>> entries;
+        std::size_t number_entries = 0;
+    };
+
+    static const std::size_t MAX_ENTRIES_PER_SCHEMA = 10000;
+
+    std::vector<SchemaCache> schemas;
+
+    SparseStatePacker packer;
+
+    std::size_t hits;
+    std::size_t misses;
+
+    bool matches(const SchemaCache &schema, const Entry &entry, const DBState &state) const;
+
+public:
+    explicit InstantiationCache(const Task &task) : packer(task), hits(0), misses(0) {}
+
+    /**
+     * Set the predicates read by the schema with the given index, i.e., the fluent
+     * relations of its positive and negated preconditions.
+     */
+    void set_read_set(int schema, std::vector<int> read_predicates);
+
+    std::size_t compute_key(int schema, const DBState &state) const;
+
+    //! Return the cached instantiations, or nullptr if the read set was not seen yet
+    const std::vector<LiftedOperatorId> *lookup(int schema, std::size_t key, const DBState &state);
+
+    void insert(int schema, std::size_t key, const DBState &state,
+                const std::vector<LiftedOperatorId> &applicable);
+
+    void print_statistics() const;
+};
+
+#endif //SEARCH_INSTANTIATION_CACHE_H
@@ -63,15 +63,19 @@ Table OrderedJoinSuccessorGenerator<OrderT>::instantiate(const ActionSchema &act
     assert(!tables.empty());
     assert(tables.size() == actiondata.relevant_precondition_atoms.size());
 
+    vector<Table> negated_tables;
+    parse_negated_precond(actiondata, state, negated_tables);
+
     Table &working_table = tables[order[0]];
+    filter_negated_preconditions(negated_tables, working_table);
     for (size_t i = 1; i < tables.size(); ++i) {
-        hash_join(working_table, tables[order[i]]);
-        // Filter out equalities
-        filter_inequalities(action, working_table);
+        hash_join(working_table, tables[order[i]], actiondata.inequalities);
+        filter_negated_preconditions(negated_tables, working_table);
         if (working_table.tuples.empty()) {
             return working_table;
         }
     }
+    assert(negated_tables.empty());
 
     return working_table;
 }
@@ -40,6 +40,8 @@ public:
     virtual DBState generate_successor(const LiftedOperatorId &op,
                                const ActionSchema& action,
                                const DBState &state) = 0;
+
+    virtual void print_statistics() const {}
 };
 
 #endif //SEARCH_SUCCESSOR_GENERATOR_H
@@ -2,6 +2,7 @@
 #include "successor_generator_factory.h"
 
 #include "full_reducer_successor_generator.h"
+#include "hybrid_successor.h"
 #include "naive_successor.h"
 #include "ordered_join_successor.h"
 #include "random_successor.h"
@@ -13,31 +14,38 @@
 
 #include <boost/algorithm/string.hpp>
 
-SuccessorGenerator *SuccessorGeneratorFactory::create(const std::string &method,
-                                                      unsigned seed,
-                                                      Task &task)
+SuccessorGenerator *SuccessorGeneratorFactory::create(const Options &opt, Task &task, utils::Budget &budget)
 {
     std::cout << "Creating successor generator factory..." << std::endl;
+    const std::string &method = opt.get_successor_generator();
+    GenericJoinSuccessor *generator;
     if (boost::iequals(method, "join")) {
-        return new NaiveSuccessorGenerator(task);
+        generator = new NaiveSuccessorGenerator(task);
     }
     else if (boost::iequals(method, "full_reducer")) {
-        return new FullReducerSuccessorGenerator(task);
+        generator = new FullReducerSuccessorGenerator(task);
     }
     else if (boost::iequals(method, "inverse_ordered_join")) {
-        return new OrderedJoinSuccessorGenerator<InverseOrderTable>(task);
+        generator = new OrderedJoinSuccessorGenerator<InverseOrderTable>(task);
     }
     else if (boost::iequals(method, "ordered_join")) {
-        return new OrderedJoinSuccessorGenerator<OrderTable>(task);
+        generator = new OrderedJoinSuccessorGenerator<OrderTable>(task);
     }
     else if (boost::iequals(method, "random_join")) {
-        return new RandomSuccessorGenerator(task, seed);
+        generator = new RandomSuccessorGenerator(task, opt.get_seed());
     }
     else if (boost::iequals(method, "yannakakis")) {
-        return new YannakakisSuccessorGenerator(task);
+        generator = new YannakakisSuccessorGenerator(task);
+    }
+    else if (boost::iequals(method, "hybrid")) {
+        generator = new HybridSuccessorGenerator(task, opt.get_grounding_threshold(), budget);
     }
     else {
         std::cerr << "Invalid successor generator method \"" << method << "\"" << std::endl;
         exit(-1);
     }
+    if (opt.get_cache_instantiations()) {
+        generator->enable_instantiation_cache(task);
+    }
+    return generator;
 }
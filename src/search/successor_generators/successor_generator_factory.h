@@ -1,16 +1,18 @@
 #ifndef SEARCH_SUCCESSOR_GENERATOR_FACTORY_H
 #define SEARCH_SUCCESSOR_GENERATOR_FACTORY_H
 
-#include <string>
+#include "../options.h"
 
 class Task;
 class SuccessorGenerator;
 
+namespace utils {
+class Budget;
+}
+
 class SuccessorGeneratorFactory {
 public:
-    static SuccessorGenerator *create(const std::string &method,
-                                      unsigned seed,
-                                      Task &task);
+    static SuccessorGenerator *create(const Options &opt, Task &task, utils::Budget &budget);
 };
 
 
@@ -7,6 +7,7 @@
 #include "../task.h"
 
 #include <cassert>
+#include <limits>
 #include <stack>
 #include <queue>
 #include <iostream>
@@ -27,7 +28,9 @@ using namespace std;
  * @param task
  */
 YannakakisSuccessorGenerator::YannakakisSuccessorGenerator(const Task &task)
-    : GenericJoinSuccessor(task) {
+    : GenericJoinSuccessor(task),
+      join_size_limit(numeric_limits<size_t>::max()),
+      join_size_limit_exceeded(false) {
     /*
       * Apply GYO algorithm for every action schema to check whether it has acyclic precondition/
       *
@@ -141,11 +144,12 @@ YannakakisSuccessorGenerator::YannakakisSuccessorGenerator(const Task &task)
             }
         } else {
             priority_queue<pair<int, int>> q;
+            const auto &atoms = action_data[action.get_index()].relevant_precondition_atoms;
             remaining_join[action.get_index()].clear();
             remaining_join[action.get_index()].reserve(
                 removed.size() + missing_precond.size());
             for (size_t k = 0; k < missing_precond.size(); ++k) {
-                q.emplace(action.get_precondition()[k].arguments.size(),
+                q.emplace(atoms[missing_precond[k]].arguments.size(),
                           missing_precond[k]);
             }
             for (size_t k = 0; k < removed.size(); ++k) {
@@ -172,6 +176,12 @@ void YannakakisSuccessorGenerator::get_distinguished_variables(const ActionSchem
             distinguished_variables[action.get_index()].insert(i.second);
         }
     }
+    for (const Atom &a : action_data[action.get_index()].negated_precondition_atoms) {
+        for (const Argument &arg : a.arguments) {
+            if (!arg.constant)
+                distinguished_variables[action.get_index()].insert(arg.index);
+        }
+    }
 }
 
 /**
@@ -231,25 +241,38 @@ Table YannakakisSuccessorGenerator::instantiate(const ActionSchema &action,
             }
         }
         Table &working_table = tables[j.second];
-        hash_join(working_table, tables[j.first]);
         // Project must be after removal of inequality constraints, otherwise we might keep only the tuple violating
         // some inequality. Variables in inequalities are also considered distinguished.
-        filter_inequalities(action, working_table);
+        if (!hash_join(working_table, tables[j.first], actiondata.inequalities, join_size_limit)) {
+            join_size_limit_exceeded = true;
+            return working_table;
+        }
         project(working_table, project_over);
         if (working_table.tuples.empty()) {
             return working_table;
         }
     }
 
+    // Negated preconditions are only checked in the final join, after the join tree has been
+    // processed, as their variables are considered distinguished.
+    vector<Table> negated_tables;
+    parse_negated_precond(actiondata, state, negated_tables);
+
     // For the case where the action schema is cyclic
     Table &working_table = tables[remaining_join[action.get_index()][0]];
+    filter_negated_preconditions(negated_tables, working_table);
     for (size_t i = 1; i < remaining_join[action.get_index()].size(); ++i) {
-        hash_join(working_table, tables[remaining_join[action.get_index()][i]]);
-        filter_inequalities(action, working_table);
+        if (!hash_join(working_table, tables[remaining_join[action.get_index()][i]],
+                       actiondata.inequalities, join_size_limit)) {
+            join_size_limit_exceeded = true;
+            return working_table;
+        }
+        filter_negated_preconditions(negated_tables, working_table);
         if (working_table.tuples.empty()) {
             return working_table;
         }
     }
+    assert(negated_tables.empty());
 
     project(working_table, distinguished_variables[action.get_index()]);
     return working_table;
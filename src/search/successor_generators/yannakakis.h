@@ -15,6 +15,15 @@ class YannakakisSuccessorGenerator : public GenericJoinSuccessor {
   Table instantiate(const ActionSchema &action,
                     const DBState &state) final;
 
+ protected:
+  /*
+   * Maximum number of tuples of the joins in instantiate(). If a join exceeds it,
+   * instantiate() returns an incomplete table and sets join_size_limit_exceeded.
+   * Only used by derived classes during their setup.
+   */
+  std::size_t join_size_limit;
+  bool join_size_limit_exceeded;
+
  private:
   std::vector<std::vector<std::pair<int, int>>> full_reducer_order;
 
@@ -3,6 +3,7 @@
 
 #include "action_schema.h"
 #include "goal_condition.h"
+#include "invariants.h"
 #include "object.h"
 #include "predicate.h"
 #include "states/state.h"
@@ -34,6 +35,8 @@ public:
   std::vector<ActionSchema> actions;
   std::vector<std::string> type_names;
   std::unordered_set<int> nullary_predicates;
+  // Mutex groups of the task, empty unless computed with synthesize_invariants
+  std::vector<Invariant> invariants;
 
   Task(const std::string &domain_name, const std::string &task_name)
       : domain_name(domain_name), task_name(task_name) {
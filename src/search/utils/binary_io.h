@@ -0,0 +1,79 @@
+#ifndef SEARCH_UTILS_BINARY_IO_H
+#define SEARCH_UTILS_BINARY_IO_H
+
+#include <cstdint>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+/*
+  Raw binary (de)serialization of plain values and vectors of plain values. The data is
+  written in the byte order of the machine, so it is only meant to be read back on the
+  same machine (e.g., search checkpoints).
+*/
+
+namespace utils {
+template<typename T>
+void write_binary(std::ostream &out, const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written");
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+T read_binary(std::istream &in) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read");
+    T value{};
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return value;
+}
+
+template<typename T>
+void write_binary_vector(std::ostream &out, const std::vector<T> &values) {
+    write_binary<std::uint64_t>(out, values.size());
+    if (!values.empty())
+        out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+/*
+  Return true if the stream holds at least the given number of bytes after the current
+  position. The bytes already buffered are checked first, so the stream is only sought
+  for large reads. Non-seekable streams are assumed to hold enough bytes.
+*/
+inline bool has_bytes_left(std::istream &in, std::uint64_t bytes) {
+    if (!in)
+        return false;
+    std::streamsize buffered = in.rdbuf()->in_avail();
+    if (buffered > 0 and std::uint64_t(buffered) >= bytes)
+        return true;
+    std::istream::pos_type position = in.tellg();
+    if (position == std::istream::pos_type(-1))
+        return true;
+    in.seekg(0, std::ios::end);
+    std::istream::pos_type end = in.tellg();
+    in.seekg(position);
+    return end != std::istream::pos_type(-1) and std::uint64_t(end - position) >= bytes;
+}
+
+/*
+  Read a vector written by write_binary_vector. If the stored length exceeds the bytes
+  left in the stream (e.g., a truncated or corrupted file), the failbit is set and an
+  empty vector is returned instead of allocating it.
+*/
+template<typename T>
+std::vector<T> read_binary_vector(std::istream &in) {
+    std::uint64_t size = read_binary<std::uint64_t>(in);
+    if (!in or size == 0)
+        return {};
+    if (size > std::uint64_t(-1) / sizeof(T) or !has_bytes_left(in, size * sizeof(T))) {
+        in.setstate(std::ios::failbit);
+        return {};
+    }
+    std::vector<T> values(size);
+    in.read(reinterpret_cast<char *>(values.data()), size * sizeof(T));
+    return values;
+}
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include "budget.h"
+
+#include <iostream>
+
+using namespace std;
+
+namespace utils {
+static const chrono::milliseconds CHECK_INTERVAL(100);
+
+Budget::Budget() : Budget(0, 0, 0) {}
+
+Budget::Budget(double wall_time_limit, double cpu_time_limit, int memory_limit_in_mb)
+    : wall_time_limit(wall_time_limit),
+      cpu_time_limit(cpu_time_limit),
+      memory_limit_in_kb(memory_limit_in_mb > 0 ? memory_limit_in_mb * 1024 : 0),
+      start_wall_time(chrono::steady_clock::now()),
+      start_cpu_time(clock()),
+      next_check(start_wall_time),
+      exhausted(false),
+      exit_code(ExitCode::SEARCH_OUT_OF_TIME) {
+    // Without limits, the next check never comes
+    if (!is_limited())
+        next_check = chrono::steady_clock::time_point::max();
+}
+
+bool Budget::is_limited() const {
+    return wall_time_limit > 0 or cpu_time_limit > 0 or memory_limit_in_kb > 0;
+}
+
+double Budget::get_wall_time() const {
+    return chrono::duration<double>(chrono::steady_clock::now() - start_wall_time).count();
+}
+
+void Budget::check_limits(chrono::steady_clock::time_point now) {
+    next_check = now + CHECK_INTERVAL;
+    double wall_time = chrono::duration<double>(now - start_wall_time).count();
+    double cpu_time = double(clock() - start_cpu_time) / CLOCKS_PER_SEC;
+    if ((wall_time_limit > 0 and wall_time >= wall_time_limit) or
+        (cpu_time_limit > 0 and cpu_time >= cpu_time_limit)) {
+        exhausted = true;
+        exit_code = ExitCode::SEARCH_OUT_OF_TIME;
+    } else if (memory_limit_in_kb > 0 and get_peak_memory_in_kb() >= memory_limit_in_kb) {
+        exhausted = true;
+        exit_code = ExitCode::SEARCH_OUT_OF_MEMORY;
+    }
+}
+
+void Budget::print_exhausted() const {
+    cout << (exit_code == ExitCode::SEARCH_OUT_OF_MEMORY ? "Memory" : "Time")
+         << " limit reached: " << get_wall_time() << "s wall-clock time, "
+         << double(clock() - start_cpu_time) / CLOCKS_PER_SEC << "s CPU time, "
+         << get_peak_memory_in_kb() << " KB peak memory" << endl;
+}
+
+int Budget::terminate_sat_solver(void *budget) {
+    return static_cast<Budget *>(budget)->is_exhausted();
+}
+}
@@ -0,0 +1,63 @@
+#ifndef UTILS_BUDGET_H
+#define UTILS_BUDGET_H
+
+#include "system.h"
+
+#include <chrono>
+#include <ctime>
+
+namespace utils {
+/*
+  Wall-clock, CPU time and memory limits of a planner run, checked
+  cooperatively by the search engines and the SAT planner.
+
+  is_exhausted() is meant to be called in the main loops of the engines: it
+  only reads the wall clock, and checks all limits at most every 100ms.
+  Once a limit is exceeded, the budget stays exhausted.
+*/
+class Budget {
+    // Non-positive limits are disabled
+    double wall_time_limit;
+    double cpu_time_limit;
+    int memory_limit_in_kb;
+
+    std::chrono::steady_clock::time_point start_wall_time;
+    std::clock_t start_cpu_time;
+    std::chrono::steady_clock::time_point next_check;
+
+    bool exhausted;
+    ExitCode exit_code;
+
+    void check_limits(std::chrono::steady_clock::time_point now);
+public:
+    //! Unlimited budget
+    Budget();
+    Budget(double wall_time_limit, double cpu_time_limit, int memory_limit_in_mb);
+
+    bool is_exhausted() {
+        if (exhausted)
+            return true;
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_check)
+            check_limits(now);
+        return exhausted;
+    }
+
+    bool is_limited() const;
+
+    //! SEARCH_OUT_OF_TIME or SEARCH_OUT_OF_MEMORY, depending on the limit exceeded
+    ExitCode get_exit_code() const {
+        return exit_code;
+    }
+
+    double get_wall_time() const;
+
+    //! Print the limit that was exceeded and the resources used
+    void print_exhausted() const;
+
+    //! Callback for ipasir_set_terminate, the state must point to a Budget
+    static int terminate_sat_solver(void *budget);
+};
+}
+
+#endif
@@ -0,0 +1,93 @@
+#! /usr/bin/env python
+
+from collections import defaultdict
+
+import pddl
+
+
+# Computes, for each parameter of each action schema, an overapproximation of
+# the objects it can be instantiated with in some relaxed-reachable action.
+#
+# We keep one set of objects per argument position of each predicate, which
+# starts with the objects of the initial state. An action schema is considered
+# applicable if the intersection of the sets of the positions where a parameter
+# occurs in positive preconditions is non-empty for all its parameters. Its add
+# effects then extend the sets of the positions of the added atoms. This is
+# iterated until a fixpoint is reached. Because the sets are kept per position,
+# this is coarser (and much cheaper) than the relaxed reachability computed by
+# the Datalog model, but it is still sound.
+
+def _positive_preconditions(action):
+    for cond in action.get_action_preconditions:
+        assert isinstance(cond, pddl.Literal)
+        if not cond.negated and cond.predicate != '=':
+            yield cond
+
+
+def _parameter_objects(action, positions, reached_nullary, all_objects):
+    """
+    Return a dictionary mapping each parameter of the action to the objects
+    it can be instantiated with, or None if the action is unreachable.
+    """
+    domains = {par.name: all_objects for par in action.parameters}
+    for cond in _positive_preconditions(action):
+        if not cond.args:
+            if cond.predicate not in reached_nullary:
+                return None
+            continue
+        for index, arg in enumerate(cond.args):
+            reached = positions[(cond.predicate, index)]
+            if arg in domains:
+                domains[arg] = domains[arg] & reached
+                if not domains[arg]:
+                    return None
+            elif arg not in reached:
+                # Constant that never occurs in this position
+                return None
+    return domains
+
+
+def compute_reachable_parameter_objects(task):
+    """
+    Compute the objects each parameter of each action schema can be instantiated
+    with. Types must already be compiled into unary predicates.
+
+    :param task: STRIPS task
+    :return: dictionary mapping each action name to a dictionary from parameter
+    names to sets of object names. Unreachable actions map to None.
+    """
+    all_objects = frozenset(obj.name for obj in task.objects)
+    positions = defaultdict(set)
+    reached_nullary = set()
+    for atom in task.init:
+        if not isinstance(atom, pddl.Atom):
+            continue
+        if not atom.args:
+            reached_nullary.add(atom.predicate)
+        for index, arg in enumerate(atom.args):
+            positions[(atom.predicate, index)].add(arg)
+
+    changed = True
+    while changed:
+        changed = False
+        for action in task.actions:
+            domains = _parameter_objects(action, positions, reached_nullary, all_objects)
+            if domains is None:
+                continue
+            for eff in action.effects:
+                literal = eff.literal
+                if literal.negated:
+                    continue
+                if not literal.args and literal.predicate not in reached_nullary:
+                    reached_nullary.add(literal.predicate)
+                    changed = True
+                for index, arg in enumerate(literal.args):
+                    # Variables quantified in the effect can take any object
+                    objects = domains.get(arg, all_objects if arg.startswith('?') else {arg})
+                    reached = positions[(literal.predicate, index)]
+                    if not objects <= reached:
+                        reached |= objects
+                        changed = True
+
+    return {action.name: _parameter_objects(action, positions, reached_nullary, all_objects)
+            for action in task.actions}
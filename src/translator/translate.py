@@ -25,6 +25,7 @@ import pddl_parser
 import pddl
 import pddl_to_prolog
 import reachability
+import reachable_parameters
 import remove_predicates
 import static_predicates
 import timers
@@ -133,6 +134,9 @@ def main():
 
     print_action_schemas(task, object_index, predicate_index, type_index)
 
+    reachable = reachable_parameters.compute_reachable_parameter_objects(task)
+    print_reachable_parameter_objects(task, reachable, object_index, types_dict)
+
     test_if_experiment(options.test_experiment)
     return
 
@@ -225,6 +229,28 @@ def print_action_schemas(task, object_index, predicate_index, type_index):
                   ' '.join(i for i in args_list))
 
 
+def print_reachable_parameter_objects(task, reachable, object_index, types_dict):
+    # Print canary and the number of action schemas (in the same order as in
+    # the ACTION-SCHEMAS section). For each action schema, we print its name
+    # and number of parameters, followed by one line per parameter with
+    #    - the number N of objects the parameter can be instantiated with in
+    # some relaxed-reachable action, or -1 if it can take any object of its type
+    #    - (if N is not -1) the N object indices
+    print("REACHABLE-PARAMETERS %d" % len(task.actions))
+    for action in task.actions:
+        print(action.name, len(action.parameters))
+        domains = reachable[action.name]
+        for par in action.parameters:
+            objects = set() if domains is None else domains[par.name]
+            of_type = [obj.name for obj in task.objects
+                       if par.type_name in types_dict[obj.type_name]]
+            if objects.issuperset(of_type):
+                print(-1)
+            else:
+                indices = sorted(object_index[o] for o in objects)
+                print(len(indices), ' '.join(str(i) for i in indices))
+
+
 def print_goal(task, atom_index, object_index, predicate_index):
     # Print canary and the number of atoms in the goal, the output of each
     # individual goal atom depends on the representation we are using. See below